@@ -17,10 +17,14 @@
 #ifndef _SB_PUBLIC_ALGORITHM_H
 #define _SB_PUBLIC_ALGORITHM_H
 
+#include "SBArena.h"
 #include "SBBase.h"
 #include "SBBidiType.h"
 #include "SBCodepointSequence.h"
+#include "SBDocument.h"
 #include "SBParagraph.h"
+#include "SBParagraphRuns.h"
+#include "SBResolver.h"
 
 typedef struct _SBAlgorithm *SBAlgorithmRef;
 
@@ -35,6 +39,46 @@ typedef struct _SBAlgorithm *SBAlgorithmRef;
  */
 SBAlgorithmRef SBAlgorithmCreate(const SBCodepointSequence *codepointSequence);
 
+/**
+ * Creates an algorithm object for the specified code point sequence in an arena. The paragraphs
+ * created by the algorithm and the lines created by those paragraphs are placed in the same arena.
+ *
+ * @param arena
+ *      The arena in which to allocate the algorithm object.
+ * @param codepointSequence
+ *      The code point sequence to apply bidirectional algorithm on.
+ * @return
+ *      A reference to an algorithm object if the call was successful, NULL otherwise. It remains
+ *      valid until the arena is destroyed.
+ */
+SBAlgorithmRef SBAlgorithmCreateInArena(SBArenaRef arena, const SBCodepointSequence *codepointSequence);
+
+/**
+ * Creates a variant of an algorithm object reflecting an edit of its source string. The variant
+ * keeps its own copy of the edited string, so the source strings of both the original algorithm and
+ * the insertion may be freed afterwards, unless the paragraphs of the original algorithm are still
+ * in use.
+ *
+ * Only the code points affected by the edit are classified again; the bidirectional types of the
+ * rest of the string are carried over from the original algorithm. The paragraphs touched by the
+ * edit can be retrieved with SBAlgorithmGetEditedRange, so that only they need to be resolved.
+ *
+ * @param algorithm
+ *      The algorithm object to derive the variant from.
+ * @param offset
+ *      The index to the first code unit of the replaced range in source string.
+ * @param oldLength
+ *      The number of code units being replaced.
+ * @param insertion
+ *      The code point sequence to insert in place of the replaced range. Its encoding must match
+ *      the one of original source string. This parameter can be set to NULL if nothing is to be
+ *      inserted.
+ * @return
+ *      A reference to an algorithm object if the call was successful, NULL otherwise.
+ */
+SBAlgorithmRef SBAlgorithmCreateVariant(SBAlgorithmRef algorithm,
+    SBUInteger offset, SBUInteger oldLength, const SBCodepointSequence *insertion);
+
 /**
  * Returns a direct pointer to the bidirectional types of code units, stored in the algorithm
  * object.
@@ -47,6 +91,29 @@ SBAlgorithmRef SBAlgorithmCreate(const SBCodepointSequence *codepointSequence);
  */
 const SBBidiType *SBAlgorithmGetBidiTypesPtr(SBAlgorithmRef algorithm);
 
+/**
+ * Returns the range of paragraphs that differ from the original algorithm of a variant. The code
+ * units before this range are laid out in the same paragraphs as in the original source string,
+ * while the ones after it are laid out in the same paragraphs shifted by the change in length. So
+ * the levels of the paragraphs resolved for the original algorithm also apply to those parts of the
+ * variant.
+ *
+ * Such paragraphs still belong to the original algorithm and refer to its bidirectional types and
+ * source string; they are not attached to the variant. A caller reusing them must keep the original
+ * algorithm and its source string alive, and must itself shift the offsets of the ones following
+ * the edited range by the change in length.
+ *
+ * The range covers the whole source string if the algorithm is not a variant.
+ *
+ * @param algorithm
+ *      The algorithm object whose edited range is returned.
+ * @param offset
+ *      On output, the index to the first code unit of the edited range in source string.
+ * @param length
+ *      On output, the number of code units covering the edited range.
+ */
+void SBAlgorithmGetEditedRange(SBAlgorithmRef algorithm, SBUInteger *offset, SBUInteger *length);
+
 /**
  * Determines the boundary of first paragraph within the specified range.
  *
@@ -97,6 +164,146 @@ void SBAlgorithmGetParagraphBoundary(SBAlgorithmRef algorithm,
 SBParagraphRef SBAlgorithmCreateParagraph(SBAlgorithmRef algorithm,
     SBUInteger paragraphOffset, SBUInteger suggestedLength, SBLevel baseLevel);
 
+/**
+ * Creates a paragraph object in the same way as SBAlgorithmCreateParagraph, but aborts as soon as
+ * any of the given resource limits is hit.
+ *
+ * @param algorithm
+ *      The algorithm object to use for creating the desired paragraph.
+ * @param paragraphOffset
+ *      The index to the first code unit of the paragraph in source string.
+ * @param suggestedLength
+ *      The number of code units covering the suggested length of the paragraph.
+ * @param baseLevel
+ *      The desired base level of the paragraph. Rules P2-P3 would be ignored if it is neither
+ *      SBLevelDefaultLTR nor SBLevelDefaultRTL.
+ * @param limits
+ *      The limits on the resources consumed by the resolution, or NULL to impose no limits.
+ * @param status
+ *      A pointer to a variable that receives SBResolverStatusCompleted on success,
+ *      SBResolverStatusLimitExceeded if a limit has been hit, SBResolverStatusFailed otherwise. It
+ *      can be NULL if the status is not needed.
+ * @return
+ *      A reference to a paragraph object if the call was successful, NULL otherwise.
+ */
+SBParagraphRef SBAlgorithmCreateParagraphWithLimits(SBAlgorithmRef algorithm,
+    SBUInteger paragraphOffset, SBUInteger suggestedLength, SBLevel baseLevel,
+    const SBResourceLimits *limits, SBResolverStatus *status);
+
+/**
+ * Creates a paragraph runs object, which keeps the resolved embedding levels of a paragraph as
+ * runs instead of one level per code unit.
+ *
+ * The paragraph is identified and resolved in the same way as SBAlgorithmCreateParagraph, but the
+ * memory held by the resulting object depends only on the number of level changes.
+ *
+ * @param algorithm
+ *      The algorithm object to use for creating the desired paragraph runs.
+ * @param paragraphOffset
+ *      The index to the first code unit of the paragraph in source string.
+ * @param suggestedLength
+ *      The number of code units covering the suggested length of the paragraph.
+ * @param baseLevel
+ *      The desired base level of the paragraph. Rules P2-P3 would be ignored if it is neither
+ *      SBLevelDefaultLTR nor SBLevelDefaultRTL.
+ * @return
+ *      A reference to a paragraph runs object if the call was successful, NULL otherwise.
+ */
+SBParagraphRunsRef SBAlgorithmCreateParagraphRuns(SBAlgorithmRef algorithm,
+    SBUInteger paragraphOffset, SBUInteger suggestedLength, SBLevel baseLevel);
+
+/**
+ * Creates two paragraph objects of the same range, one resolved with base level 0 and the other one
+ * with base level 1.
+ *
+ * All of the rules from X1 onwards depend on the base level, so the paragraph is resolved in full
+ * for each direction, and the call costs about as much as creating both paragraphs separately. It
+ * only spares determining the boundary twice, reuses a single resolution context, and either
+ * creates both paragraphs or none of them.
+ *
+ * @param algorithm
+ *      The algorithm object to use for creating the desired paragraphs.
+ * @param paragraphOffset
+ *      The index to the first code unit of the paragraphs in source string.
+ * @param suggestedLength
+ *      The number of code units covering the suggested length of the paragraphs.
+ * @param ltrParagraph
+ *      A pointer to a variable that receives the paragraph resolved with base level 0.
+ * @param rtlParagraph
+ *      A pointer to a variable that receives the paragraph resolved with base level 1.
+ * @return
+ *      SBTrue if both paragraphs were created successfully, SBFalse otherwise. The variables
+ *      receive NULL in case of failure.
+ */
+SBBoolean SBAlgorithmCreateParagraphPair(SBAlgorithmRef algorithm,
+    SBUInteger paragraphOffset, SBUInteger suggestedLength,
+    SBParagraphRef *ltrParagraph, SBParagraphRef *rtlParagraph);
+
+/**
+ * Creates a resolver object which resolves a paragraph in a number of steps, so that the work can
+ * be interleaved with other tasks.
+ *
+ * The paragraph is identified and resolved in the same way as SBAlgorithmCreateParagraph, but
+ * nothing beyond preparing the bidi chain is done until the resolver is stepped.
+ *
+ * @param algorithm
+ *      The algorithm object to use for creating the desired paragraph.
+ * @param paragraphOffset
+ *      The index to the first code unit of the paragraph in source string.
+ * @param suggestedLength
+ *      The number of code units covering the suggested length of the paragraph.
+ * @param baseLevel
+ *      The desired base level of the paragraph. Rules P2-P3 would be ignored if it is neither
+ *      SBLevelDefaultLTR nor SBLevelDefaultRTL.
+ * @return
+ *      A reference to a resolver object if the call was successful, NULL otherwise.
+ */
+SBResolverRef SBAlgorithmCreateResolver(SBAlgorithmRef algorithm,
+    SBUInteger paragraphOffset, SBUInteger suggestedLength, SBLevel baseLevel);
+
+/**
+ * Creates a resolver object in the same way as SBAlgorithmCreateResolver, which aborts the
+ * resolution as soon as any of the given resource limits is hit.
+ *
+ * If the paragraph cannot be resolved within the limits from the very start, the returned resolver
+ * reports SBResolverStatusLimitExceeded without allocating the resolution state.
+ *
+ * @param algorithm
+ *      The algorithm object to use for creating the desired paragraph.
+ * @param paragraphOffset
+ *      The index to the first code unit of the paragraph in source string.
+ * @param suggestedLength
+ *      The number of code units covering the suggested length of the paragraph.
+ * @param baseLevel
+ *      The desired base level of the paragraph. Rules P2-P3 would be ignored if it is neither
+ *      SBLevelDefaultLTR nor SBLevelDefaultRTL.
+ * @param limits
+ *      The limits on the resources consumed by the resolution, or NULL to impose no limits.
+ * @return
+ *      A reference to a resolver object if the call was successful, NULL otherwise.
+ */
+SBResolverRef SBAlgorithmCreateResolverWithLimits(SBAlgorithmRef algorithm,
+    SBUInteger paragraphOffset, SBUInteger suggestedLength, SBLevel baseLevel,
+    const SBResourceLimits *limits);
+
+/**
+ * Resolves all paragraphs of the source string in one call, storing their embedding levels in one
+ * contiguous array along with a table of paragraphs.
+ *
+ * The paragraph boundaries are located in a single walk over the string, and each paragraph is then
+ * resolved in the same way as SBAlgorithmCreateParagraph, but with a resolution state that is
+ * allocated once and reused for all of them.
+ *
+ * @param algorithm
+ *      The algorithm object to use for resolving the paragraphs.
+ * @param baseLevel
+ *      The desired base level of each paragraph. Rules P2-P3 would be ignored if it is neither
+ *      SBLevelDefaultLTR nor SBLevelDefaultRTL.
+ * @return
+ *      A reference to a document object if the call was successful, NULL otherwise.
+ */
+SBDocumentRef SBAlgorithmResolveAll(SBAlgorithmRef algorithm, SBLevel baseLevel);
+
 /**
  * Increments the reference count of an algorithm object.
  *
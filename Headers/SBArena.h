@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _SB_PUBLIC_ARENA_H
+#define _SB_PUBLIC_ARENA_H
+
+#include "SBBase.h"
+
+typedef struct _SBArena *SBArenaRef;
+
+/**
+ * Creates an arena from which objects are allocated by bumping a pointer through large blocks of
+ * memory.
+ *
+ * An algorithm created in an arena places itself, all of its paragraphs and all of their lines in
+ * the arena. Retaining and releasing such objects has no effect; instead their memory is reclaimed
+ * all at once when the arena is destroyed. An arena must not be used from multiple threads at the
+ * same time.
+ *
+ * @param blockSize
+ *      The size of each block in bytes, or zero for a default size. An object larger than a block
+ *      gets a block of its own.
+ * @return
+ *      A reference to an arena object if the call was successful, NULL otherwise.
+ */
+SBArenaRef SBArenaCreate(SBUInteger blockSize);
+
+/**
+ * Returns the number of bytes handed out by an arena so far.
+ *
+ * @param arena
+ *      The arena whose allocated bytes are returned.
+ * @return
+ *      The total size of the objects allocated in the arena.
+ */
+SBUInteger SBArenaGetAllocatedBytes(SBArenaRef arena);
+
+/**
+ * Destroys an arena along with all the objects that were created in it. None of these objects may
+ * be used afterwards.
+ *
+ * @param arena
+ *      The arena to be destroyed.
+ */
+void SBArenaDestroy(SBArenaRef arena);
+
+#endif
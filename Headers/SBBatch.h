@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _SB_PUBLIC_BATCH_H
+#define _SB_PUBLIC_BATCH_H
+
+#include "SBBase.h"
+#include "SBCodepointSequence.h"
+#include "SBRun.h"
+
+/**
+ * A structure describing the resolved output of a single string of a batch.
+ */
+typedef struct _SBBatchEntry {
+    SBUInteger levelOffset; /**< The index to the first level of the string in the levels array. */
+    SBUInteger length;      /**< The number of code units in the string. */
+    SBUInteger runOffset;   /**< The index to the first run of the string in the runs array. */
+    SBUInteger runCount;    /**< The number of visual runs in the string. */
+    SBLevel baseLevel;      /**< The base level of the first paragraph of the string. */
+} SBBatchEntry;
+
+/**
+ * A structure holding the resolved output of a batch of strings. All of its arrays are carved out
+ * of a single block of memory owned by the structure.
+ */
+typedef struct _SBBatchResults {
+    const SBBatchEntry *entries; /**< One entry per string, in the order of the input. */
+    const SBLevel *levels;       /**< The embedding levels of all strings, one after another. */
+    const SBRun *runs;           /**< The visual runs of all strings, one after another. */
+    SBUInteger entryCount;       /**< The number of entries. */
+    SBUInteger levelCount;       /**< The total number of levels. */
+    SBUInteger runCount;         /**< The total number of visual runs. */
+    void *_memory;
+} SBBatchResults;
+
+/**
+ * Resolves the embedding levels and the visual runs of many strings in a single call. Each string
+ * is resolved paragraph by paragraph, the way SBAlgorithmResolveAll does, but the bidi types and
+ * the working memory of all strings share one allocation and their output another one, so
+ * resolving a large number of short strings does not pay for a separate algorithm, paragraph and
+ * line per string.
+ *
+ * The levels of a string are the ones of its paragraphs. The runs of a string are the ones that
+ * SBParagraphCreateLine would produce for a line covering each of its paragraphs, with rules L1
+ * and L2 applied; they follow the paragraphs in logical order, the runs of each paragraph are in
+ * visual order, and their offsets are relative to the start of the string.
+ *
+ * @param sequences
+ *      The code point sequences to be resolved. A sequence with zero length produces an empty
+ *      entry; any other sequence must be valid.
+ * @param count
+ *      The number of code point sequences.
+ * @param baseLevel
+ *      The desired base level of the paragraphs. It will be overridden (in accordance with the
+ *      rules P2-P3) for all paragraphs if the value is SBLevelDefaultLTR or SBLevelDefaultRTL.
+ * @param results
+ *      The structure receiving the resolved output. It must be finalized with
+ *      SBBatchResultsFinalize once the function succeeds.
+ * @return
+ *      SBTrue if all strings were resolved, SBFalse otherwise, in which case the results are left
+ *      empty.
+ */
+SBBoolean SBResolveBatch(const SBCodepointSequence *sequences, SBUInteger count,
+    SBLevel baseLevel, SBBatchResults *results);
+
+/**
+ * Releases the memory held by the results of a batch and leaves them empty.
+ *
+ * @param results
+ *      The results to be finalized.
+ */
+void SBBatchResultsFinalize(SBBatchResults *results);
+
+#endif
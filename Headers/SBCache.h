@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _SB_PUBLIC_CACHE_H
+#define _SB_PUBLIC_CACHE_H
+
+#include "SBBase.h"
+#include "SBCodepointSequence.h"
+#include "SBLine.h"
+#include "SBParagraph.h"
+
+typedef struct _SBCache *SBCacheRef;
+
+/**
+ * Acquires or relinquishes a caller-provided lock.
+ *
+ * @param object
+ *      The object of the lock.
+ */
+typedef void (*SBCacheLockFunc)(void *object);
+
+/**
+ * A structure describing a caller-provided lock guarding a cache shared among threads.
+ */
+typedef struct _SBCacheLock {
+    void *object;           /**< The object passed back to the callbacks. */
+    SBCacheLockFunc lock;   /**< The callback acquiring the lock. */
+    SBCacheLockFunc unlock; /**< The callback relinquishing the lock. */
+} SBCacheLock;
+
+/**
+ * Creates a cache of resolved strings. The entries are keyed by the code units of a string along
+ * with its encoding and the requested base level, and the least recently used ones are evicted
+ * whenever the memory held by the cache exceeds its budget.
+ *
+ * Each cached paragraph keeps its own copy of the string, which is shared by the cached line, so
+ * the source string may be freed as soon as a lookup returns.
+ *
+ * @param byteBudget
+ *      The maximum number of bytes that the cached objects may occupy.
+ * @param lock
+ *      The lock guarding the cache if it is shared among threads, or NULL. It is copied by the
+ *      cache.
+ * @return
+ *      A reference to a cache object if the call was successful, NULL otherwise.
+ */
+SBCacheRef SBCacheCreate(SBUInteger byteBudget, const SBCacheLock *lock);
+
+/**
+ * Returns the paragraph covering the first paragraph of a string, resolving the string only if
+ * it is not already present in the cache.
+ *
+ * @param cache
+ *      The cache to look the string up in.
+ * @param codepointSequence
+ *      The code point sequence of the string.
+ * @param baseLevel
+ *      The desired base level of the paragraph. It will be overridden (in accordance with the
+ *      rules P2-P3) if the value is SBLevelDefaultLTR or SBLevelDefaultRTL.
+ * @return
+ *      A retained paragraph which may be shared with other callers, or NULL if the string could not
+ *      be resolved. It must be released with SBCacheReleaseParagraph.
+ */
+SBParagraphRef SBCacheGetParagraph(SBCacheRef cache,
+    const SBCodepointSequence *codepointSequence, SBLevel baseLevel);
+
+/**
+ * Returns the line covering the first paragraph of a string, resolving the string only if it is
+ * not already present in the cache.
+ *
+ * The reference count of a shared line is guarded by the lock of the cache, so the line must not
+ * be passed to anything that retains it outside the lock, such as SBMirrorLocatorLoadLine. Create
+ * a line of the cached paragraph for such uses instead.
+ *
+ * @param cache
+ *      The cache to look the string up in.
+ * @param codepointSequence
+ *      The code point sequence of the string.
+ * @param baseLevel
+ *      The desired base level of the paragraph. It will be overridden (in accordance with the
+ *      rules P2-P3) if the value is SBLevelDefaultLTR or SBLevelDefaultRTL.
+ * @return
+ *      A retained line which may be shared with other callers, or NULL if the string could not be
+ *      resolved. It must be released with SBCacheReleaseLine.
+ */
+SBLineRef SBCacheGetLine(SBCacheRef cache,
+    const SBCodepointSequence *codepointSequence, SBLevel baseLevel);
+
+/**
+ * Releases a paragraph obtained from a cache while holding the lock of the cache, as the
+ * paragraph may be shared with other threads.
+ *
+ * @param cache
+ *      The cache from which the paragraph was obtained.
+ * @param paragraph
+ *      The paragraph to be released.
+ */
+void SBCacheReleaseParagraph(SBCacheRef cache, SBParagraphRef paragraph);
+
+/**
+ * Releases a line obtained from a cache while holding the lock of the cache, as the line may be
+ * shared with other threads.
+ *
+ * @param cache
+ *      The cache from which the line was obtained.
+ * @param line
+ *      The line to be released.
+ */
+void SBCacheReleaseLine(SBCacheRef cache, SBLineRef line);
+
+/**
+ * Returns the number of lookups that were answered from the cache.
+ *
+ * @param cache
+ *      The cache whose hit count is returned.
+ * @return
+ *      The number of cache hits.
+ */
+SBUInteger SBCacheGetHitCount(SBCacheRef cache);
+
+/**
+ * Returns the number of lookups that had to resolve their string.
+ *
+ * @param cache
+ *      The cache whose miss count is returned.
+ * @return
+ *      The number of cache misses.
+ */
+SBUInteger SBCacheGetMissCount(SBCacheRef cache);
+
+/**
+ * Returns the number of strings present in the cache.
+ *
+ * @param cache
+ *      The cache whose entry count is returned.
+ * @return
+ *      The number of cached strings.
+ */
+SBUInteger SBCacheGetEntryCount(SBCacheRef cache);
+
+/**
+ * Returns the number of bytes occupied by the cached objects.
+ *
+ * @param cache
+ *      The cache whose used bytes are returned.
+ * @return
+ *      The memory held by the cache, which never exceeds its budget.
+ */
+SBUInteger SBCacheGetUsedBytes(SBCacheRef cache);
+
+/**
+ * Removes all entries from a cache. The objects still retained by callers remain valid.
+ *
+ * @param cache
+ *      The cache to be cleared.
+ */
+void SBCacheClear(SBCacheRef cache);
+
+/**
+ * Increments the reference count of a cache object.
+ *
+ * @param cache
+ *      The cache object whose reference count will be incremented.
+ * @return
+ *      The same cache object passed in as the parameter.
+ */
+SBCacheRef SBCacheRetain(SBCacheRef cache);
+
+/**
+ * Decrements the reference count of a cache object. The object will be deallocated when its
+ * reference count reaches zero.
+ *
+ * @param cache
+ *      The cache object whose reference count will be decremented.
+ */
+void SBCacheRelease(SBCacheRef cache);
+
+#endif
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _SB_PUBLIC_DOCUMENT_H
+#define _SB_PUBLIC_DOCUMENT_H
+
+#include "SBBase.h"
+
+typedef struct _SBDocument *SBDocumentRef;
+
+/**
+ * A structure containing the information of a paragraph resolved as part of a document.
+ */
+typedef struct _SBParagraphInfo {
+    SBUInteger offset; /**< The index to the first code unit of the paragraph in source string. */
+    SBUInteger length; /**< The number of code units covering the length of the paragraph. */
+    SBLevel baseLevel; /**< The resolved base level of the paragraph. */
+} SBParagraphInfo;
+
+/**
+ * Returns the number of code units covering the length of the document.
+ *
+ * @param document
+ *      The document whose length is returned.
+ * @return
+ *      The length of the document passed in.
+ */
+SBUInteger SBDocumentGetLength(SBDocumentRef document);
+
+/**
+ * Returns the number of paragraphs in the document.
+ *
+ * @param document
+ *      The document whose paragraph count is returned.
+ * @return
+ *      The number of paragraphs in the document passed in.
+ */
+SBUInteger SBDocumentGetParagraphCount(SBDocumentRef document);
+
+/**
+ * Returns a direct pointer to the paragraph table, stored in the document.
+ *
+ * @param document
+ *      The document from which to access the paragraphs.
+ * @return
+ *      A valid pointer to an array of SBParagraphInfo structures, in logical order.
+ */
+const SBParagraphInfo *SBDocumentGetParagraphsPtr(SBDocumentRef document);
+
+/**
+ * Returns a direct pointer to the embedding levels of all paragraphs, stored in the document.
+ *
+ * @param document
+ *      The document from which to access the embedding levels.
+ * @return
+ *      A valid pointer to an array of SBLevel structures, indexed by the code units of source
+ *      string.
+ */
+const SBLevel *SBDocumentGetLevelsPtr(SBDocumentRef document);
+
+/**
+ * Increments the reference count of a document object.
+ *
+ * @param document
+ *      The document object whose reference count will be incremented.
+ * @return
+ *      The same document object passed in as the parameter.
+ */
+SBDocumentRef SBDocumentRetain(SBDocumentRef document);
+
+/**
+ * Decrements the reference count of a document object. The object will be deallocated when its
+ * reference count reaches zero.
+ *
+ * @param document
+ *      The document object whose reference count will be decremented.
+ */
+void SBDocumentRelease(SBDocumentRef document);
+
+#endif
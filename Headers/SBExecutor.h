@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _SB_PUBLIC_EXECUTOR_H
+#define _SB_PUBLIC_EXECUTOR_H
+
+#include "SBBase.h"
+
+/**
+ * A unit of work that the library hands over to an executor.
+ *
+ * @param data
+ *      The data that was supplied along with the task.
+ */
+typedef void (*SBExecutorTaskFunc)(void *data);
+
+/**
+ * Schedules a task on the workers of an executor. The task may run on any thread, including the
+ * calling one, but it must be run exactly once.
+ *
+ * @param object
+ *      The object of the executor.
+ * @param task
+ *      The task to be run.
+ * @param data
+ *      The data to be passed to the task.
+ */
+typedef void (*SBExecutorSubmitFunc)(void *object, SBExecutorTaskFunc task, void *data);
+
+/**
+ * Blocks the calling thread until all tasks submitted to an executor have been run.
+ *
+ * @param object
+ *      The object of the executor.
+ */
+typedef void (*SBExecutorWaitFunc)(void *object);
+
+/**
+ * A structure describing a caller-provided task executor. The library never spawns threads of its
+ * own; instead it distributes independent work over the executor and waits for its completion
+ * before returning.
+ */
+typedef struct _SBExecutor {
+    void *object;                /**< The object passed back to the callbacks. */
+    SBUInteger concurrency;      /**< The number of tasks that may run at the same time. */
+    SBExecutorSubmitFunc submit; /**< The callback scheduling a task. */
+    SBExecutorWaitFunc wait;     /**< The callback waiting for all scheduled tasks. */
+} SBExecutor;
+
+#endif
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _SB_PUBLIC_HIT_INDEX_H
+#define _SB_PUBLIC_HIT_INDEX_H
+
+#include "SBBase.h"
+#include "SBLine.h"
+
+typedef struct _SBHitIndex *SBHitIndexRef;
+
+/**
+ * Creates an index over the visual positions of the code units of a line, so that hit testing and
+ * caret placement do not need to walk the runs on every event.
+ *
+ * The advances are accumulated once in visual order, after which a position can be mapped to a
+ * code unit and vice versa in logarithmic and constant time respectively. The index does not keep
+ * a reference to the line.
+ *
+ * @param line
+ *      The line whose code units are indexed.
+ * @param advances
+ *      An array of size equal to the length of the line, containing the non-negative advance of
+ *      each code unit in logical order. The code units not starting a glyph cluster, such as the
+ *      trailing units of a code point, should have a zero advance.
+ * @return
+ *      A reference to a hit index object if the call was successful, NULL otherwise.
+ */
+SBHitIndexRef SBHitIndexCreate(SBLineRef line, const SBInteger *advances);
+
+/**
+ * Returns the total advance of the indexed line.
+ *
+ * @param hitIndex
+ *      The hit index object whose line width is returned.
+ * @return
+ *      The sum of the advances of all code units.
+ */
+SBInteger SBHitIndexGetWidth(SBHitIndexRef hitIndex);
+
+/**
+ * Finds the code unit displayed at a position of the line, measured from its left edge. The
+ * positions beyond either edge of the line resolve to the outermost code unit on that side.
+ *
+ * @param hitIndex
+ *      The hit index object to be queried.
+ * @param position
+ *      The position to be tested.
+ * @param isTrailing
+ *      A pointer to a boolean, which will receive SBTrue if the position lies in the logically
+ *      trailing half of the code unit, i.e. the right half in left-to-right runs and the left half
+ *      in right-to-left runs. This parameter can be set to NULL if not needed.
+ * @return
+ *      The index to the hit code unit in source string, or the offset of the line if it is empty.
+ */
+SBUInteger SBHitIndexGetOffsetAtPosition(SBHitIndexRef hitIndex,
+    SBInteger position, SBBoolean *isTrailing);
+
+/**
+ * Returns the position of a caret placed before a code unit, i.e. at the leading edge of the code
+ * unit, which is its left edge in left-to-right runs and its right edge in right-to-left runs.
+ *
+ * @param hitIndex
+ *      The hit index object to be queried.
+ * @param offset
+ *      The index to a code unit in source string. An index at or beyond the end of the line places
+ *      the caret at the trailing edge of its last code unit, and an index before the line places
+ *      it at the leading edge of its first code unit.
+ * @return
+ *      The position of the caret, measured from the left edge of the line.
+ */
+SBInteger SBHitIndexGetCaretPosition(SBHitIndexRef hitIndex, SBUInteger offset);
+
+/**
+ * Increments the reference count of a hit index object.
+ *
+ * @param hitIndex
+ *      The hit index object whose reference count will be incremented.
+ * @return
+ *      The same hit index object passed in as the parameter.
+ */
+SBHitIndexRef SBHitIndexRetain(SBHitIndexRef hitIndex);
+
+/**
+ * Decrements the reference count of a hit index object. The object will be deallocated when its
+ * reference count reaches zero.
+ *
+ * @param hitIndex
+ *      The hit index object whose reference count will be decremented.
+ */
+void SBHitIndexRelease(SBHitIndexRef hitIndex);
+
+#endif
@@ -18,10 +18,36 @@
 #define _SB_PUBLIC_LINE_H
 
 #include "SBBase.h"
+#include "SBCodepointSequence.h"
 #include "SBRun.h"
 
 typedef struct _SBLine *SBLineRef;
 
+/**
+ * A value representing a run having no match in the previous version of a line.
+ */
+#define SBRunMatchNone              ((SBUInteger)(-1))
+
+/**
+ * A structure describing a range of code units in the visual order of a line, where the code units
+ * of all runs are laid out one after another and the ones of right-to-left runs are reversed.
+ */
+typedef struct _SBVisualRange {
+    SBUInteger offset; /**< The visual index to the first code unit of the range in the line. */
+    SBUInteger length; /**< The number of code units covering the length of the range. */
+} SBVisualRange;
+
+/**
+ * A structure describing a piece of a line having a single bidi level and a single attribute run
+ * of the caller, such as a style or font run, which can be shaped as a whole.
+ */
+typedef struct _SBLineItem {
+    SBUInteger offset;         /**< The index to the first code unit of the item in source string. */
+    SBUInteger length;         /**< The number of code units covering the length of the item. */
+    SBUInteger attributeIndex; /**< The index of the attribute run containing the item. */
+    SBLevel level;             /**< The embedding level of the item. */
+} SBLineItem;
+
 /**
  * Returns the index to the first code unit of the line in source string.
  *
@@ -62,6 +88,110 @@ SBUInteger SBLineGetRunCount(SBLineRef line);
  */
 const SBRun *SBLineGetRunsPtr(SBLineRef line);
 
+/**
+ * Matches the runs of a line against the ones of its previous version, so that the results derived
+ * from unchanged runs, such as shaped glyphs, can be kept.
+ *
+ * The edit made to the source string in between is described by a range of the previous string
+ * replaced by a number of new code units. A run is considered unchanged if it does not overlap the
+ * edit and the previous line contains a run with the same level and the same range, after shifting
+ * the offset by the change in length if the run follows the edit. The two lines may also belong to
+ * the same source string, in which case both of the lengths should be zero.
+ *
+ * @param line
+ *      The line whose runs are matched.
+ * @param previousLine
+ *      The previous version of the line.
+ * @param editOffset
+ *      The index to the first code unit of the edited range in source string.
+ * @param oldLength
+ *      The number of code units replaced in previous source string.
+ * @param newLength
+ *      The number of code units inserted in their place.
+ * @param runMatches
+ *      An array of size equal to the run count of the line, which will receive the index of the
+ *      matching run of previous line for each run, or SBRunMatchNone if the run has changed. This
+ *      parameter can be set to NULL if not needed.
+ * @return
+ *      The number of changed runs in the line.
+ */
+SBUInteger SBLineMatchRuns(SBLineRef line, SBLineRef previousLine,
+    SBUInteger editOffset, SBUInteger oldLength, SBUInteger newLength, SBUInteger *runMatches);
+
+/**
+ * Copies the code points of a line in visual order, with the ones of right-to-left runs reversed
+ * and replaced by their mirrors where available, in accordance with Rules L2 and L4 of Unicode
+ * Bidirectional Algorithm. The code points are never split, so multi-unit code points stay intact.
+ *
+ * Nothing is written if the buffer is not large enough to hold the whole string, so the function
+ * can be called with a NULL buffer to determine the required capacity.
+ *
+ * @param line
+ *      The line whose visual string is copied.
+ * @param encoding
+ *      The encoding of the output string, which may differ from that of source string.
+ * @param buffer
+ *      The buffer in which to write the code units of the visual string.
+ * @param capacity
+ *      The number of code units the buffer can hold.
+ * @return
+ *      The number of code units of the visual string, or zero if the encoding is invalid.
+ */
+SBUInteger SBLineCopyVisualString(SBLineRef line, SBStringEncoding encoding,
+    void *buffer, SBUInteger capacity);
+
+/**
+ * Converts a logical range of source string, such as a selection, into the ranges it covers in the
+ * visual order of a line. The ranges are reported from left to right, and the ones touching each
+ * other visually are merged, so that each of them can be painted as a single rectangle.
+ *
+ * Only as many ranges as fit in the array are written, so the function can be called with zero
+ * capacity to determine the number of ranges.
+ *
+ * @param line
+ *      The line whose visual ranges are determined.
+ * @param offset
+ *      The index to the first code unit of the logical range in source string.
+ * @param length
+ *      The number of code units covering the length of the logical range. The part lying outside
+ *      the line is ignored.
+ * @param ranges
+ *      An array in which to write the visual ranges.
+ * @param capacity
+ *      The number of ranges the array can hold.
+ * @return
+ *      The total number of visual ranges covered by the logical range.
+ */
+SBUInteger SBLineGetVisualRangesForLogicalRange(SBLineRef line,
+    SBUInteger offset, SBUInteger length, SBVisualRange *ranges, SBUInteger capacity);
+
+/**
+ * Splits the runs of a line at the boundaries of caller attribute runs, providing the items to be
+ * shaped in visual order. The items of a right-to-left run are reported from its logical end, so
+ * that they can be laid out from left to right as they are.
+ *
+ * Only as many items as fit in the array are written, so the function can be called with zero
+ * capacity to determine the number of items.
+ *
+ * @param line
+ *      The line whose items are determined.
+ * @param attributeOffsets
+ *      An array containing the index to the first code unit of each attribute run in source string
+ *      in increasing order. Each attribute run extends up to the start of the next one, and the
+ *      first one is considered to cover everything before it as well.
+ * @param attributeCount
+ *      The number of attribute runs. If it is zero, every item has an attribute index of zero.
+ * @param items
+ *      An array in which to write the items.
+ * @param capacity
+ *      The number of items the array can hold.
+ * @return
+ *      The total number of items in the line.
+ */
+SBUInteger SBLineGetItems(SBLineRef line,
+    const SBUInteger *attributeOffsets, SBUInteger attributeCount,
+    SBLineItem *items, SBUInteger capacity);
+
 /**
  * Increments the reference count of a line object.
  *
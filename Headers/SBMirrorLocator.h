@@ -100,4 +100,39 @@ SBMirrorLocatorRef SBMirrorLocatorRetain(SBMirrorLocatorRef locator);
  */
 void SBMirrorLocatorRelease(SBMirrorLocatorRef locator);
 
+/**
+ * Collects all mirrors of a line at once, in the same order in which a mirror locator would find
+ * them.
+ *
+ * Only as many agents as fit in the array are written, so the function can be called with zero
+ * capacity to determine the number of mirrors.
+ *
+ * @param line
+ *      The line whose mirrors are collected.
+ * @param agents
+ *      An array in which to write the agents of located mirrors.
+ * @param capacity
+ *      The number of agents the array can hold.
+ * @return
+ *      The total number of mirrors in the line.
+ */
+SBUInteger SBLineGetMirrors(SBLineRef line, SBMirrorAgent *agents, SBUInteger capacity);
+
+/**
+ * Replaces the code points of a caller-provided buffer with their mirrors, for all mirrors of a
+ * line.
+ *
+ * @param line
+ *      The line whose mirrors are applied.
+ * @param codepoints
+ *      The buffer whose code points are replaced by mirrors.
+ * @param indexMap
+ *      An array mapping each code unit of the line, relative to its offset, to an index in the
+ *      buffer. This parameter can be set to NULL if the buffer is indexed by code units of the
+ *      line directly.
+ * @return
+ *      The number of replaced code points.
+ */
+SBUInteger SBLineApplyMirroring(SBLineRef line, SBCodepoint *codepoints, const SBUInteger *indexMap);
+
 #endif
@@ -18,10 +18,24 @@
 #define _SB_PUBLIC_PARAGRAPH_H
 
 #include "SBBase.h"
+#include "SBExecutor.h"
 #include "SBLine.h"
 
 typedef struct _SBParagraph *SBParagraphRef;
 
+/**
+ * Measures the width of a run of a candidate line while fitting a line.
+ *
+ * @param object
+ *      The object that was supplied along with the function.
+ * @param run
+ *      A run of the candidate line in logical order, whose level reflects rule L1 of Unicode
+ *      Bidirectional Algorithm. The pointer is valid only during the call.
+ * @return
+ *      The width of the run.
+ */
+typedef SBInteger (*SBRunMeasureFunc)(void *object, const SBRun *run);
+
 /**
  * Returns the index to the first code unit of the paragraph in source string.
  *
@@ -78,6 +92,68 @@ const SBLevel *SBParagraphGetLevelsPtr(SBParagraphRef paragraph);
  */
 SBLineRef SBParagraphCreateLine(SBParagraphRef paragraph, SBUInteger lineOffset, SBUInteger lineLength);
 
+/**
+ * Creates a number of consecutive line objects by applying rules L1-L2 of Unicode Bidirectional
+ * Algorithm on each of them. The lines are distributed over the workers of the given executor.
+ *
+ * @param paragraph
+ *      The paragraph that creates the lines.
+ * @param lineOffset
+ *      The index to the first code unit of the first line in source string. It should occur
+ *      within the range of paragraph.
+ * @param lineLengths
+ *      An array containing the number of code units covering the length of each line. Every line
+ *      starts right after the previous one and all of them should occur within the range of
+ *      paragraph.
+ * @param lineCount
+ *      The number of lines to be created.
+ * @param executor
+ *      The executor on which the lines will be created. If it is NULL, or its concurrency is less
+ *      than two, the lines are created on the calling thread.
+ * @param lines
+ *      An array that receives the created lines. It must be able to hold lineCount references.
+ * @return
+ *      SBTrue if all of the lines were created successfully, SBFalse otherwise. In case of failure,
+ *      no line is returned and each element of the array is set to NULL.
+ */
+SBBoolean SBParagraphCreateLinesParallel(SBParagraphRef paragraph,
+    SBUInteger lineOffset, const SBUInteger *lineLengths, SBUInteger lineCount,
+    const SBExecutor *executor, SBLineRef *lines);
+
+/**
+ * Creates the longest line among a number of candidates that fits in a given width, typically the
+ * ones ending at the break opportunities following the line offset.
+ *
+ * A candidate is measured as the sum of the widths of its runs, which are derived from levels
+ * resolved once for the longest candidate; only the trailing white space of each candidate is
+ * reset on the fly. So no line object is created, and nothing is allocated, for the candidates
+ * that are merely tried. The candidates are searched in binary fashion, assuming that a longer
+ * candidate is never narrower than a shorter one.
+ *
+ * @param paragraph
+ *      The paragraph that creates the line.
+ * @param lineOffset
+ *      The index to the first code unit of the line in source string. It should occur within the
+ *      range of paragraph.
+ * @param lineLengths
+ *      An array containing the number of code units of each candidate in increasing order. All of
+ *      the candidates should occur within the range of paragraph.
+ * @param candidateCount
+ *      The number of candidates.
+ * @param maxWidth
+ *      The width available to the line.
+ * @param measureRun
+ *      The function measuring the width of a run.
+ * @param object
+ *      The object to be passed to the measuring function.
+ * @return
+ *      A reference to a line object of the longest fitting candidate, or of the shortest one if
+ *      none fits, if the call was successful, NULL otherwise.
+ */
+SBLineRef SBParagraphCreateFittingLine(SBParagraphRef paragraph,
+    SBUInteger lineOffset, const SBUInteger *lineLengths, SBUInteger candidateCount,
+    SBInteger maxWidth, SBRunMeasureFunc measureRun, void *object);
+
 /**
  * Increments the reference count of a paragraph object.
  *
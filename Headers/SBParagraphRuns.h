@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _SB_PUBLIC_PARAGRAPH_RUNS_H
+#define _SB_PUBLIC_PARAGRAPH_RUNS_H
+
+#include "SBBase.h"
+#include "SBRun.h"
+
+typedef struct _SBParagraphRuns *SBParagraphRunsRef;
+
+/**
+ * Returns the index to the first code unit of the paragraph in source string.
+ *
+ * @param paragraphRuns
+ *      The paragraph runs whose offset is returned.
+ * @return
+ *      The offset of the paragraph runs passed in.
+ */
+SBUInteger SBParagraphRunsGetOffset(SBParagraphRunsRef paragraphRuns);
+
+/**
+ * Returns the number of code units covering the length of the paragraph.
+ *
+ * @param paragraphRuns
+ *      The paragraph runs whose length is returned.
+ * @return
+ *      The length of the paragraph runs passed in.
+ */
+SBUInteger SBParagraphRunsGetLength(SBParagraphRunsRef paragraphRuns);
+
+/**
+ * Returns the base level of the paragraph.
+ *
+ * @param paragraphRuns
+ *      The paragraph runs whose base level is returned.
+ * @return
+ *      The base level of the paragraph runs passed in.
+ */
+SBLevel SBParagraphRunsGetBaseLevel(SBParagraphRunsRef paragraphRuns);
+
+/**
+ * Returns the number of level runs in the paragraph.
+ *
+ * @param paragraphRuns
+ *      The paragraph runs whose run count is returned.
+ * @return
+ *      The number of runs in the paragraph runs passed in.
+ */
+SBUInteger SBParagraphRunsGetRunCount(SBParagraphRunsRef paragraphRuns);
+
+/**
+ * Returns a direct pointer to the level runs, stored in logical order. No two adjacent runs have
+ * the same embedding level.
+ *
+ * @param paragraphRuns
+ *      The paragraph runs from which to access the level runs.
+ * @return
+ *      A valid pointer to an array of SBRun structures.
+ */
+const SBRun *SBParagraphRunsGetRunsPtr(SBParagraphRunsRef paragraphRuns);
+
+/**
+ * Returns the embedding level of a code unit.
+ *
+ * @param paragraphRuns
+ *      The paragraph runs containing the code unit.
+ * @param index
+ *      The index to the code unit in source string.
+ * @return
+ *      The embedding level of the code unit, or SBLevelInvalid if it lies outside the paragraph.
+ */
+SBLevel SBParagraphRunsGetLevelAt(SBParagraphRunsRef paragraphRuns, SBUInteger index);
+
+/**
+ * Writes a bit mask marking the code units of a range having odd, i.e. right-to-left, embedding
+ * levels.
+ *
+ * @param paragraphRuns
+ *      The paragraph runs containing the range.
+ * @param maskOffset
+ *      The index to the first code unit of the range in source string.
+ * @param maskLength
+ *      The number of code units covering the length of the range.
+ * @param mask
+ *      The buffer receiving the mask. It must hold at least (maskLength + 7) / 8 bytes. The code
+ *      unit at maskOffset + i is represented by bit (i % 8) of byte (i / 8). The bits of code units
+ *      lying outside the paragraph are cleared.
+ */
+void SBParagraphRunsGetOddLevelMask(SBParagraphRunsRef paragraphRuns,
+    SBUInteger maskOffset, SBUInteger maskLength, SBUInt8 *mask);
+
+/**
+ * Increments the reference count of a paragraph runs object.
+ *
+ * @param paragraphRuns
+ *      The paragraph runs object whose reference count will be incremented.
+ * @return
+ *      The same paragraph runs object passed in as the parameter.
+ */
+SBParagraphRunsRef SBParagraphRunsRetain(SBParagraphRunsRef paragraphRuns);
+
+/**
+ * Decrements the reference count of a paragraph runs object. The object will be deallocated when
+ * its reference count reaches zero.
+ *
+ * @param paragraphRuns
+ *      The paragraph runs object whose reference count will be decremented.
+ */
+void SBParagraphRunsRelease(SBParagraphRunsRef paragraphRuns);
+
+#endif
@@ -0,0 +1,244 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _SB_PUBLIC_RECORD_H
+#define _SB_PUBLIC_RECORD_H
+
+#include "SBBase.h"
+#include "SBLine.h"
+#include "SBMirrorLocator.h"
+#include "SBParagraph.h"
+#include "SBRun.h"
+
+/**
+ * The version of the record format written by this library.
+ */
+#define SBRecordVersion     1
+
+/**
+ * A read-only view over a record of a resolved paragraph and its lines. The view does not copy the
+ * record, so the underlying memory, which may as well be a mapped file, must remain valid while the
+ * view is in use.
+ */
+typedef struct _SBRecordView {
+    const void *_data;
+} SBRecordView;
+
+/**
+ * Writes a compact binary record of a resolved paragraph along with its lines, so that the layout
+ * can later be loaded without running the algorithm. The record holds the base level, the level
+ * runs of the paragraph and, for each line, its reordered runs and the positions of the code points
+ * that need to be mirrored.
+ *
+ * All fields of the record are 32-bit unsigned integers stored in the byte order of the machine
+ * writing it; a record written on a machine of a different byte order is rejected by the view.
+ *
+ * @param paragraph
+ *      The paragraph to be recorded.
+ * @param lines
+ *      The lines of the paragraph to be recorded, or NULL if lineCount is zero.
+ * @param lineCount
+ *      The number of lines.
+ * @param buffer
+ *      The buffer receiving the record, aligned to at least four bytes, or NULL to measure the
+ *      record only.
+ * @param bufferSize
+ *      The size of the buffer in bytes.
+ * @return
+ *      The size of the record in bytes, which is written only if it fits in the buffer, or zero if
+ *      a line is NULL or lies outside the paragraph, or a value does not fit in the format.
+ */
+SBUInteger SBRecordWrite(SBParagraphRef paragraph, const SBLineRef *lines, SBUInteger lineCount,
+    void *buffer, SBUInteger bufferSize);
+
+/**
+ * Initializes a view over a record after verifying its header and the bounds of its tables.
+ *
+ * @param view
+ *      The view to be initialized.
+ * @param data
+ *      The record, aligned to at least four bytes.
+ * @param dataSize
+ *      The number of bytes available at data.
+ * @return
+ *      SBTrue if the data holds a valid record of a supported version, SBFalse otherwise.
+ */
+SBBoolean SBRecordViewInitialize(SBRecordView *view, const void *data, SBUInteger dataSize);
+
+/**
+ * Returns the size of the record in bytes.
+ *
+ * @param view
+ *      The view of the record.
+ * @return
+ *      The size of the record.
+ */
+SBUInteger SBRecordViewGetSize(const SBRecordView *view);
+
+/**
+ * Returns the index to the first code unit of the recorded paragraph in source string.
+ *
+ * @param view
+ *      The view of the record.
+ * @return
+ *      The offset of the recorded paragraph.
+ */
+SBUInteger SBRecordViewGetOffset(const SBRecordView *view);
+
+/**
+ * Returns the number of code units covering the length of the recorded paragraph.
+ *
+ * @param view
+ *      The view of the record.
+ * @return
+ *      The length of the recorded paragraph.
+ */
+SBUInteger SBRecordViewGetLength(const SBRecordView *view);
+
+/**
+ * Returns the base level of the recorded paragraph.
+ *
+ * @param view
+ *      The view of the record.
+ * @return
+ *      The base level of the recorded paragraph.
+ */
+SBLevel SBRecordViewGetBaseLevel(const SBRecordView *view);
+
+/**
+ * Returns the number of level runs of the recorded paragraph.
+ *
+ * @param view
+ *      The view of the record.
+ * @return
+ *      The number of level runs.
+ */
+SBUInteger SBRecordViewGetLevelRunCount(const SBRecordView *view);
+
+/**
+ * Reads a level run of the recorded paragraph. The level runs are stored in logical order.
+ *
+ * @param view
+ *      The view of the record.
+ * @param runIndex
+ *      The index of the level run, which must be less than the level run count.
+ * @param run
+ *      The structure receiving the level run.
+ */
+void SBRecordViewGetLevelRun(const SBRecordView *view, SBUInteger runIndex, SBRun *run);
+
+/**
+ * Returns the embedding level of a code unit of the recorded paragraph.
+ *
+ * @param view
+ *      The view of the record.
+ * @param index
+ *      The index to the code unit in source string.
+ * @return
+ *      The embedding level of the code unit, or SBLevelInvalid if it lies outside the paragraph.
+ */
+SBLevel SBRecordViewGetLevelAt(const SBRecordView *view, SBUInteger index);
+
+/**
+ * Returns the number of recorded lines.
+ *
+ * @param view
+ *      The view of the record.
+ * @return
+ *      The number of lines.
+ */
+SBUInteger SBRecordViewGetLineCount(const SBRecordView *view);
+
+/**
+ * Returns the index to the first code unit of a recorded line in source string.
+ *
+ * @param view
+ *      The view of the record.
+ * @param lineIndex
+ *      The index of the line, which must be less than the line count.
+ * @return
+ *      The offset of the line.
+ */
+SBUInteger SBRecordViewGetLineOffset(const SBRecordView *view, SBUInteger lineIndex);
+
+/**
+ * Returns the number of code units covering the length of a recorded line.
+ *
+ * @param view
+ *      The view of the record.
+ * @param lineIndex
+ *      The index of the line, which must be less than the line count.
+ * @return
+ *      The length of the line.
+ */
+SBUInteger SBRecordViewGetLineLength(const SBRecordView *view, SBUInteger lineIndex);
+
+/**
+ * Returns the number of runs of a recorded line.
+ *
+ * @param view
+ *      The view of the record.
+ * @param lineIndex
+ *      The index of the line, which must be less than the line count.
+ * @return
+ *      The number of runs in the line.
+ */
+SBUInteger SBRecordViewGetLineRunCount(const SBRecordView *view, SBUInteger lineIndex);
+
+/**
+ * Reads a run of a recorded line. The runs are stored in visual order.
+ *
+ * @param view
+ *      The view of the record.
+ * @param lineIndex
+ *      The index of the line, which must be less than the line count.
+ * @param runIndex
+ *      The index of the run, which must be less than the run count of the line.
+ * @param run
+ *      The structure receiving the run.
+ */
+void SBRecordViewGetLineRun(const SBRecordView *view, SBUInteger lineIndex,
+    SBUInteger runIndex, SBRun *run);
+
+/**
+ * Returns the number of code points of a recorded line that need to be mirrored.
+ *
+ * @param view
+ *      The view of the record.
+ * @param lineIndex
+ *      The index of the line, which must be less than the line count.
+ * @return
+ *      The number of mirrors in the line.
+ */
+SBUInteger SBRecordViewGetLineMirrorCount(const SBRecordView *view, SBUInteger lineIndex);
+
+/**
+ * Reads a mirror of a recorded line, in the same order as reported by the mirror locator.
+ *
+ * @param view
+ *      The view of the record.
+ * @param lineIndex
+ *      The index of the line, which must be less than the line count.
+ * @param mirrorIndex
+ *      The index of the mirror, which must be less than the mirror count of the line.
+ * @param agent
+ *      The structure receiving the absolute index of the code point, its mirror and the code point
+ *      itself.
+ */
+void SBRecordViewGetLineMirror(const SBRecordView *view, SBUInteger lineIndex,
+    SBUInteger mirrorIndex, SBMirrorAgent *agent);
+
+#endif
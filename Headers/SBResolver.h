@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _SB_PUBLIC_RESOLVER_H
+#define _SB_PUBLIC_RESOLVER_H
+
+#include "SBBase.h"
+#include "SBParagraph.h"
+
+typedef struct _SBResolver *SBResolverRef;
+
+/**
+ * A structure restricting the resources that may be consumed while resolving a paragraph. A value
+ * of zero in any of the fields means that the corresponding resource is not limited.
+ */
+typedef struct _SBResourceLimits {
+    SBUInteger maxParagraphLength;  /**< The maximum number of code units in the paragraph. */
+    SBUInteger maxAllocatedBytes;   /**< The maximum number of bytes allocated for the resolution. */
+    SBUInteger maxOperations;       /**< The maximum number of links processed by all passes. */
+} SBResourceLimits;
+
+/**
+ * Constants that specify the status of a resolver.
+ */
+enum {
+    SBResolverStatusInProgress    = 0, /**< The paragraph is still being resolved. */
+    SBResolverStatusCompleted     = 1, /**< The paragraph has been resolved completely. */
+    SBResolverStatusFailed        = 2, /**< The resolution could not be completed. */
+    SBResolverStatusLimitExceeded = 3  /**< The resolution was aborted due to a resource limit. */
+};
+/**
+ * A type to represent the status of a resolver.
+ */
+typedef SBUInt8 SBResolverStatus;
+
+/**
+ * Advances the resolution of the paragraph by approximately the given number of links, where a
+ * link is a sequence of code units sharing the same bidi type. The resolution stops as soon as the
+ * budget is exhausted and continues from the same position on the next call.
+ *
+ * Explicit levels are determined one link at a time, while each isolating run is resolved in a
+ * number of passes, each one costing as many links as the code units covered by the run.
+ *
+ * @param resolver
+ *      The resolver whose paragraph needs to be resolved.
+ * @param budgetLinks
+ *      The number of links that can be processed in this call.
+ * @return
+ *      SBResolverStatusInProgress if the resolution needs more steps, SBResolverStatusCompleted if
+ *      the paragraph has been resolved, SBResolverStatusLimitExceeded if a resource limit has been
+ *      hit, SBResolverStatusFailed otherwise.
+ */
+SBResolverStatus SBResolverStep(SBResolverRef resolver, SBUInteger budgetLinks);
+
+/**
+ * Advances the resolution of the paragraph only as far as needed to finalize the levels of the
+ * code units in range [0, requestedLength) relative to the paragraph offset.
+ *
+ * The levels are final once all isolating runs covering the range have been resolved, so the
+ * resolved length may go beyond the requested one. Later calls continue from the same position.
+ *
+ * @param resolver
+ *      The resolver whose paragraph needs to be resolved.
+ * @param requestedLength
+ *      The number of code units, from the start of the paragraph, whose levels are needed.
+ * @return
+ *      The status of the resolver after advancing it. It remains SBResolverStatusInProgress if the
+ *      requested levels have been finalized before the whole paragraph.
+ */
+SBResolverStatus SBResolverAdvance(SBResolverRef resolver, SBUInteger requestedLength);
+
+/**
+ * Returns the current status of the resolver.
+ *
+ * @param resolver
+ *      The resolver whose status is returned.
+ * @return
+ *      The status of the resolver passed in.
+ */
+SBResolverStatus SBResolverGetStatus(SBResolverRef resolver);
+
+/**
+ * Returns the paragraph resolved by the resolver.
+ *
+ * @param resolver
+ *      The resolver whose paragraph is returned.
+ * @return
+ *      A reference to the resolved paragraph if the resolution has been completed, NULL otherwise.
+ *      The paragraph is owned by the resolver and should be retained in order to outlive it.
+ */
+SBParagraphRef SBResolverGetParagraph(SBResolverRef resolver);
+
+/**
+ * Returns the number of code units, from the start of the paragraph, whose levels are final.
+ *
+ * @param resolver
+ *      The resolver whose resolved length is returned.
+ * @return
+ *      The number of code units whose levels can be read from SBResolverGetLevelsPtr.
+ */
+SBUInteger SBResolverGetResolvedLength(SBResolverRef resolver);
+
+/**
+ * Returns a direct pointer to the embedding levels resolved so far, stored in the resolver.
+ *
+ * @param resolver
+ *      The resolver from which to access the embedding levels.
+ * @return
+ *      A valid pointer to an array of SBLevel structures, of which only as many as returned by
+ *      SBResolverGetResolvedLength are final, or NULL if the resolution has been aborted.
+ */
+const SBLevel *SBResolverGetLevelsPtr(SBResolverRef resolver);
+
+/**
+ * Increments the reference count of a resolver object.
+ *
+ * @param resolver
+ *      The resolver object whose reference count will be incremented.
+ * @return
+ *      The same resolver object passed in as the parameter.
+ */
+SBResolverRef SBResolverRetain(SBResolverRef resolver);
+
+/**
+ * Decrements the reference count of a resolver object. The object will be deallocated when its
+ * reference count reaches zero.
+ *
+ * @param resolver
+ *      The resolver object whose reference count will be decremented.
+ */
+void SBResolverRelease(SBResolverRef resolver);
+
+#endif
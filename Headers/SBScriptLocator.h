@@ -19,6 +19,7 @@
 
 #include "SBBase.h"
 #include "SBCodepointSequence.h"
+#include "SBExecutor.h"
 #include "SBScript.h"
 
 typedef struct _SBScriptLocator *SBScriptLocatorRef;
@@ -50,6 +51,26 @@ SBScriptLocatorRef SBScriptLocatorCreate(void);
  */
 void SBScriptLocatorLoadCodepoints(SBScriptLocatorRef locator, const SBCodepointSequence *codepointSequence);
 
+/**
+ * Loads a code point sequence in the locator and resolves all of its script runs in advance by
+ * distributing the work over the given executor.
+ *
+ * The sequence is split into chunks at code points having a concrete script, preferably the ones
+ * following a white space. The chunks are resolved concurrently and their runs are stitched at the
+ * seams, so that the locator reports exactly the same runs as it would after loading the sequence
+ * with SBScriptLocatorLoadCodepoints.
+ *
+ * @param locator
+ *      The locator in which the code point sequence will be loaded.
+ * @param codepointSequence
+ *      The code point sequence which will be loaded in the locator.
+ * @param executor
+ *      The executor on which the chunks will be resolved. If it is NULL, its concurrency is less
+ *      than two, or the sequence is too short to be split, the runs are located sequentially.
+ */
+void SBScriptLocatorLoadCodepointsParallel(SBScriptLocatorRef locator,
+    const SBCodepointSequence *codepointSequence, const SBExecutor *executor);
+
 /**
  * Returns the agent containing the information of current located script run.
  *
@@ -70,6 +91,32 @@ const SBScriptAgent *SBScriptLocatorGetAgent(SBScriptLocatorRef locator);
  */
 SBBoolean SBScriptLocatorMoveNext(SBScriptLocatorRef locator);
 
+/**
+ * Sets the interval, in code units, at which the locator records the state of its bracket pairs
+ * while locating the runs sequentially. The recorded checkpoints let SBScriptLocatorSeek resume
+ * from a nearby position instead of the start of the code point sequence.
+ *
+ * @param locator
+ *      The locator whose checkpoint interval is set.
+ * @param interval
+ *      The minimum number of code units between two checkpoints, or zero to disable them, which is
+ *      the default.
+ */
+void SBScriptLocatorSetCheckpointInterval(SBScriptLocatorRef locator, SBUInteger interval);
+
+/**
+ * Positions the locator so that the next call to SBScriptLocatorMoveNext finds the script run
+ * containing the given offset, resuming from the last checkpoint before it. Further checkpoints
+ * are recorded on the way, so later seeks in the same area are cheaper.
+ *
+ * @param locator
+ *      The locator whom you want to position.
+ * @param offset
+ *      The index to a code unit in the loaded code point sequence. If it is beyond the sequence,
+ *      no more runs are found.
+ */
+void SBScriptLocatorSeek(SBScriptLocatorRef locator, SBUInteger offset);
+
 /**
  * Instructs the locator to reset itself so that script runs of the loaded line can be obatained
  * from the beginning.
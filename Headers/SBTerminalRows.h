@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _SB_PUBLIC_TERMINAL_ROWS_H
+#define _SB_PUBLIC_TERMINAL_ROWS_H
+
+#include "SBBase.h"
+#include "SBCodepoint.h"
+
+typedef struct _SBTerminalRows *SBTerminalRowsRef;
+
+/**
+ * A structure describing the contents of a screen row.
+ */
+typedef struct _SBTerminalRow {
+    const SBCodepoint *cells; /**< The code points of the row, one for each cell. */
+    SBUInteger cellCount;     /**< The number of cells in the row. */
+    SBUInteger generation;    /**< A caller-maintained identity of the row contents, or zero. */
+} SBTerminalRow;
+
+/**
+ * A structure containing the visual layout of a screen row.
+ */
+typedef struct _SBTerminalRowLayout {
+    const SBUInteger *visualMap;  /**< The logical index of the cell displayed at each visual cell. */
+    const SBBoolean *mirrorFlags; /**< Whether the glyph at each visual cell must be mirrored. */
+    SBUInteger cellCount;         /**< The number of cells in the row. */
+    SBLevel baseLevel;            /**< The resolved base level of the row. */
+} SBTerminalRowLayout;
+
+/**
+ * Creates an object keeping the resolved layouts of screen rows, so that unchanged rows are not
+ * resolved again on every redraw.
+ *
+ * The layouts are looked up by the generation of a row if it is nonzero, which spares hashing the
+ * contents of the row, and by a hash of its contents otherwise. The contents are compared in both
+ * cases, so the generations need not be distinct across rows; a counter kept per row, for example,
+ * works fine. Either way, a row keeps its layout when it moves to another position on the screen,
+ * so scrolling does not cause any resolution.
+ *
+ * @param capacity
+ *      The maximum number of rows whose layouts are kept, which must be at least the number of
+ *      rows resolved at once.
+ * @param baseLevel
+ *      The desired base level of every row. It will be overridden (in accordance with the rules
+ *      P2-P3) if the value is SBLevelDefaultLTR or SBLevelDefaultRTL.
+ * @return
+ *      A reference to a terminal rows object if the call was successful, NULL otherwise.
+ */
+SBTerminalRowsRef SBTerminalRowsCreate(SBUInteger capacity, SBLevel baseLevel);
+
+/**
+ * Provides the visual layouts of a set of screen rows, typically the visible ones, resolving only
+ * the rows whose layouts are not already kept. The least recently used layouts are discarded to
+ * make room for new ones.
+ *
+ * Each row is treated as a line of its own. The cells of a row are displayed in the order given by
+ * its visual map, and the cells whose mirror flag is set must be displayed with the mirrored glyph
+ * of their code point.
+ *
+ * @param terminalRows
+ *      The terminal rows object keeping the layouts.
+ * @param rows
+ *      The rows whose layouts are needed.
+ * @param rowCount
+ *      The number of rows, which must not exceed the capacity of the terminal rows object.
+ * @param layouts
+ *      An array of size equal to the row count, which will receive the layout of each row. The
+ *      layouts remain valid until the next call to this function or until the object is
+ *      deallocated.
+ * @return
+ *      SBTrue if the layouts of all rows were provided, SBFalse otherwise.
+ */
+SBBoolean SBTerminalRowsResolve(SBTerminalRowsRef terminalRows,
+    const SBTerminalRow *rows, SBUInteger rowCount, SBTerminalRowLayout *layouts);
+
+/**
+ * Returns the number of rows whose layouts were already kept.
+ *
+ * @param terminalRows
+ *      The terminal rows object whose hit count is returned.
+ * @return
+ *      The number of rows served without resolution.
+ */
+SBUInteger SBTerminalRowsGetHitCount(SBTerminalRowsRef terminalRows);
+
+/**
+ * Returns the number of rows that had to be resolved.
+ *
+ * @param terminalRows
+ *      The terminal rows object whose miss count is returned.
+ * @return
+ *      The number of resolved rows.
+ */
+SBUInteger SBTerminalRowsGetMissCount(SBTerminalRowsRef terminalRows);
+
+/**
+ * Discards all kept layouts, for example when the caller starts counting the generations of rows
+ * over again.
+ *
+ * @param terminalRows
+ *      The terminal rows object to be cleared.
+ */
+void SBTerminalRowsClear(SBTerminalRowsRef terminalRows);
+
+/**
+ * Increments the reference count of a terminal rows object.
+ *
+ * @param terminalRows
+ *      The terminal rows object whose reference count will be incremented.
+ * @return
+ *      The same terminal rows object passed in as the parameter.
+ */
+SBTerminalRowsRef SBTerminalRowsRetain(SBTerminalRowsRef terminalRows);
+
+/**
+ * Decrements the reference count of a terminal rows object. The object will be deallocated when
+ * its reference count reaches zero.
+ *
+ * @param terminalRows
+ *      The terminal rows object whose reference count will be decremented.
+ */
+void SBTerminalRowsRelease(SBTerminalRowsRef terminalRows);
+
+#endif
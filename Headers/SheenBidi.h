@@ -18,16 +18,26 @@
 #define _SHEEN_BIDI_H
 
 #include "SBAlgorithm.h"
+#include "SBArena.h"
 #include "SBBase.h"
+#include "SBBatch.h"
 #include "SBBidiType.h"
+#include "SBCache.h"
 #include "SBCodepoint.h"
 #include "SBCodepointSequence.h"
+#include "SBDocument.h"
+#include "SBExecutor.h"
 #include "SBGeneralCategory.h"
+#include "SBHitIndex.h"
 #include "SBLine.h"
 #include "SBMirrorLocator.h"
 #include "SBParagraph.h"
+#include "SBParagraphRuns.h"
+#include "SBRecord.h"
+#include "SBResolver.h"
 #include "SBRun.h"
 #include "SBScript.h"
 #include "SBScriptLocator.h"
+#include "SBTerminalRows.h"
 
 #endif
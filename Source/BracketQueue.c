@@ -37,6 +37,8 @@ static SBBoolean BracketQueueInsertElement(BracketQueueRef queue)
                 return SBFalse;
             }
 
+            queue->allocatedBytes += sizeof(BracketQueueList);
+
             rearList->previous = previousList;
             rearList->next = NULL;
 
@@ -75,6 +77,7 @@ SB_INTERNAL void BracketQueueInitialize(BracketQueueRef queue)
     queue->_frontList = NULL;
     queue->_rearList = NULL;
     queue->count = 0;
+    queue->allocatedBytes = 0;
     queue->shouldDequeue = SBFalse;
 }
 
@@ -43,6 +43,7 @@ typedef struct _BracketQueue {
     SBInteger _frontTop;
     SBInteger _rearTop;
     SBUInteger count;
+    SBUInteger allocatedBytes;
     SBBoolean shouldDequeue;
     SBBidiType _direction;
 } BracketQueue, *BracketQueueRef;
@@ -474,59 +474,75 @@ static void ResolveImplicitLevels(IsolatingRunRef isolatingRun)
 SB_INTERNAL void IsolatingRunInitialize(IsolatingRunRef isolatingRun)
 {
     BracketQueueInitialize(&isolatingRun->_bracketQueue);
+    isolatingRun->_pass = 0;
 }
 
-SB_INTERNAL SBBoolean IsolatingRunResolve(IsolatingRunRef isolatingRun)
+SB_INTERNAL SBBoolean IsolatingRunResolvePass(IsolatingRunRef isolatingRun, SBBoolean *isResolved)
 {
-    BidiLink lastLink;
-    BidiLink subsequentLink;
-
-    SB_LOG_BLOCK_OPENER("Identified Isolating Run");
-
-    /* Attach level run links to form isolating run. */
-    AttachLevelRunLinks(isolatingRun);
-    /* Save last subsequent link. */
-    subsequentLink = isolatingRun->_lastLevelRun->subsequentLink;
-
-    SB_LOG_STATEMENT("Range", 1, SB_LOG_RUN_RANGE(isolatingRun));
-    SB_LOG_STATEMENT("Types", 1, SB_LOG_RUN_TYPES(isolatingRun));
-    SB_LOG_STATEMENT("Level", 1, SB_LOG_LEVEL(isolatingRun->baseLevelRun->level));
-    SB_LOG_STATEMENT("SOS", 1, SB_LOG_BIDI_TYPE(isolatingRun->_sos));
-    SB_LOG_STATEMENT("EOS", 1, SB_LOG_BIDI_TYPE(isolatingRun->_eos));
-
-    /* Rules W1-W7 */
-    lastLink = ResolveWeakTypes(isolatingRun);
-    SB_LOG_BLOCK_OPENER("Resolved Weak Types");
-    SB_LOG_STATEMENT("Types", 1, SB_LOG_RUN_TYPES(isolatingRun));
-    SB_LOG_BLOCK_CLOSER();
-
-    /* Rule N0 */
-    if (!ResolveBrackets(isolatingRun)) {
-        return SBFalse;
-    }
-
-    SB_LOG_BLOCK_OPENER("Resolved Brackets");
-    SB_LOG_STATEMENT("Types", 1, SB_LOG_RUN_TYPES(isolatingRun));
-    SB_LOG_BLOCK_CLOSER();
-
-    /* Rules N1, N2 */
-    ResolveNeutrals(isolatingRun);
-    SB_LOG_BLOCK_OPENER("Resolved Neutrals");
-    SB_LOG_STATEMENT("Types", 1, SB_LOG_RUN_TYPES(isolatingRun));
-    SB_LOG_BLOCK_CLOSER();
-
-    /* Rules I1, I2 */
-    ResolveImplicitLevels(isolatingRun);
-    SB_LOG_BLOCK_OPENER("Resolved Implicit Levels");
-    SB_LOG_STATEMENT("Levels", 1, SB_LOG_RUN_LEVELS(isolatingRun));
-    SB_LOG_BLOCK_CLOSER();
+    *isResolved = SBFalse;
+
+    switch (isolatingRun->_pass) {
+    case 0:
+        SB_LOG_BLOCK_OPENER("Identified Isolating Run");
+
+        /* Attach level run links to form isolating run. */
+        AttachLevelRunLinks(isolatingRun);
+        /* Save last subsequent link. */
+        isolatingRun->_subsequentLink = isolatingRun->_lastLevelRun->subsequentLink;
+
+        SB_LOG_STATEMENT("Range", 1, SB_LOG_RUN_RANGE(isolatingRun));
+        SB_LOG_STATEMENT("Types", 1, SB_LOG_RUN_TYPES(isolatingRun));
+        SB_LOG_STATEMENT("Level", 1, SB_LOG_LEVEL(isolatingRun->baseLevelRun->level));
+        SB_LOG_STATEMENT("SOS", 1, SB_LOG_BIDI_TYPE(isolatingRun->_sos));
+        SB_LOG_STATEMENT("EOS", 1, SB_LOG_BIDI_TYPE(isolatingRun->_eos));
+
+        /* Rules W1-W7 */
+        isolatingRun->_finalLink = ResolveWeakTypes(isolatingRun);
+        SB_LOG_BLOCK_OPENER("Resolved Weak Types");
+        SB_LOG_STATEMENT("Types", 1, SB_LOG_RUN_TYPES(isolatingRun));
+        SB_LOG_BLOCK_CLOSER();
+        break;
+
+    case 1:
+        /* Rule N0 */
+        if (!ResolveBrackets(isolatingRun)) {
+            isolatingRun->_pass = 0;
+            return SBFalse;
+        }
 
-    /* Re-attach original links. */
-    AttachOriginalLinks(isolatingRun);
-    /* Attach new final link (of isolating run) with last subsequent link. */
-    BidiChainSetNext(isolatingRun->bidiChain, lastLink, subsequentLink);
+        SB_LOG_BLOCK_OPENER("Resolved Brackets");
+        SB_LOG_STATEMENT("Types", 1, SB_LOG_RUN_TYPES(isolatingRun));
+        SB_LOG_BLOCK_CLOSER();
+        break;
+
+    case 2:
+        /* Rules N1, N2 */
+        ResolveNeutrals(isolatingRun);
+        SB_LOG_BLOCK_OPENER("Resolved Neutrals");
+        SB_LOG_STATEMENT("Types", 1, SB_LOG_RUN_TYPES(isolatingRun));
+        SB_LOG_BLOCK_CLOSER();
+        break;
+
+    default:
+        /* Rules I1, I2 */
+        ResolveImplicitLevels(isolatingRun);
+        SB_LOG_BLOCK_OPENER("Resolved Implicit Levels");
+        SB_LOG_STATEMENT("Levels", 1, SB_LOG_RUN_LEVELS(isolatingRun));
+        SB_LOG_BLOCK_CLOSER();
+
+        /* Re-attach original links. */
+        AttachOriginalLinks(isolatingRun);
+        /* Attach new final link (of isolating run) with last subsequent link. */
+        BidiChainSetNext(isolatingRun->bidiChain, isolatingRun->_finalLink, isolatingRun->_subsequentLink);
+
+        SB_LOG_BLOCK_CLOSER();
+
+        isolatingRun->_pass = 0;
+        *isResolved = SBTrue;
+        return SBTrue;
+    }
 
-    SB_LOG_BLOCK_CLOSER();
+    isolatingRun->_pass += 1;
 
     return SBTrue;
 }
@@ -34,13 +34,16 @@ typedef struct _IsolatingRun {
     BracketQueue _bracketQueue;
     SBUInteger paragraphOffset;
     BidiLink _originalLink;
+    BidiLink _finalLink;
+    BidiLink _subsequentLink;
+    SBUInt8 _pass;
     SBBidiType _sos;
     SBBidiType _eos;
     SBLevel paragraphLevel;
 } IsolatingRun, *IsolatingRunRef;
 
 SB_INTERNAL void IsolatingRunInitialize(IsolatingRunRef isolatingRun);
-SB_INTERNAL SBBoolean IsolatingRunResolve(IsolatingRunRef isolatingRun);
+SB_INTERNAL SBBoolean IsolatingRunResolvePass(IsolatingRunRef isolatingRun, SBBoolean *isResolved);
 
 SB_INTERNAL void IsolatingRunFinalize(IsolatingRunRef isolatingRun);
 
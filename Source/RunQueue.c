@@ -37,6 +37,8 @@ static SBBoolean RunQueueInsertElement(RunQueueRef queue)
                 return SBFalse;
             }
 
+            queue->allocatedBytes += sizeof(RunQueueList);
+
             rearList->previous = previousList;
             rearList->next = NULL;
 
@@ -74,7 +76,6 @@ static void FindPreviousPartialRun(RunQueueRef queue)
 
     queue->_partialList = NULL;
     queue->_partialTop = -1;
-    queue->shouldDequeue = SBFalse;
 }
 
 SB_INTERNAL void RunQueueInitialize(RunQueueRef queue)
@@ -82,8 +83,14 @@ SB_INTERNAL void RunQueueInitialize(RunQueueRef queue)
     /* Initialize first list. */
     queue->_firstList.previous = NULL;
     queue->_firstList.next = NULL;
+    queue->allocatedBytes = 0;
+
+    RunQueueReset(queue);
+}
 
-    /* Initialize front and rear lists with first list. */
+SB_INTERNAL void RunQueueReset(RunQueueRef queue)
+{
+    /* Initialize front and rear lists with first list, keeping the allocated ones for reuse. */
     queue->_frontList = &queue->_firstList;
     queue->_rearList = &queue->_firstList;
     queue->_partialList = NULL;
@@ -120,6 +127,9 @@ SB_INTERNAL SBBoolean RunQueueEnqueue(RunQueueRef queue, const LevelRunRef level
             queue->_partialTop = queue->_rearTop;
         }
 
+        /* All of the queued isolating runs are complete if none of them awaits its terminator. */
+        queue->shouldDequeue = (queue->_partialTop == -1);
+
         return SBTrue;
     }
 
@@ -42,10 +42,12 @@ typedef struct _RunQueue {
     SBInteger _partialTop;          /**< Index of partial run in partial list */
     LevelRunRef peek;               /**< Peek element of the queue */
     SBUInteger count;               /**< Number of elements the queue contains */
+    SBUInteger allocatedBytes;      /**< Size of the lists allocated beyond the first one */
     SBBoolean shouldDequeue;
 } RunQueue, *RunQueueRef;
 
 SB_INTERNAL void RunQueueInitialize(RunQueueRef queue);
+SB_INTERNAL void RunQueueReset(RunQueueRef queue);
 
 SB_INTERNAL SBBoolean RunQueueEnqueue(RunQueueRef queue, const LevelRunRef levelRun);
 SB_INTERNAL void RunQueueDequeue(RunQueueRef queue);
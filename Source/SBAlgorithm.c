@@ -17,31 +17,40 @@
 #include <SBConfig.h>
 #include <stddef.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "BidiTypeLookup.h"
+#include "SBArena.h"
 #include "SBBase.h"
 #include "SBCodepointSequence.h"
+#include "SBDocument.h"
 #include "SBLog.h"
 #include "SBParagraph.h"
+#include "SBParagraphRuns.h"
+#include "SBResolver.h"
 #include "SBAlgorithm.h"
 
-static SBAlgorithmRef AllocateAlgorithm(SBUInteger stringLength)
+static SBAlgorithmRef AllocateAlgorithm(SBArenaRef arena, SBUInteger stringLength, SBUInteger stringSize)
 {
     const SBUInteger sizeAlgorithm = sizeof(SBAlgorithm);
+    const SBUInteger sizeString    = stringSize;
     const SBUInteger sizeTypes     = sizeof(SBBidiType) * stringLength;
-    const SBUInteger sizeMemory    = sizeAlgorithm + sizeTypes;
+    const SBUInteger sizeMemory    = sizeAlgorithm + sizeString + sizeTypes;
 
-    void *pointer = malloc(sizeMemory);
+    void *pointer = (arena ? SBArenaAllocate(arena, sizeMemory) : malloc(sizeMemory));
 
     if (pointer) {
         const SBUInteger offsetAlgorithm = 0;
-        const SBUInteger offsetTypes     = offsetAlgorithm + sizeAlgorithm;
+        const SBUInteger offsetString    = offsetAlgorithm + sizeAlgorithm;
+        const SBUInteger offsetTypes     = offsetString + sizeString;
 
         SBUInt8 *memory = (SBUInt8 *)pointer;
         SBAlgorithmRef algorithm = (SBAlgorithmRef)(memory + offsetAlgorithm);
         SBLevel *fixedTypes = (SBLevel *)(memory + offsetTypes);
 
+        algorithm->fixedString = (sizeString ? memory + offsetString : NULL);
         algorithm->fixedTypes = fixedTypes;
+        algorithm->arena = arena;
 
         return algorithm;
     }
@@ -51,7 +60,9 @@ static SBAlgorithmRef AllocateAlgorithm(SBUInteger stringLength)
 
 static void DisposeAlgorithm(SBAlgorithmRef algorithm)
 {
-    free(algorithm);
+    if (!algorithm->arena) {
+        free(algorithm);
+    }
 }
 
 static void DetermineBidiTypes(const SBCodepointSequence *sequence, SBBidiType *types)
@@ -70,21 +81,35 @@ static void DetermineBidiTypes(const SBCodepointSequence *sequence, SBBidiType *
     }
 }
 
-static SBAlgorithmRef CreateAlgorithm(const SBCodepointSequence *codepointSequence)
+static SBAlgorithmRef CreateAlgorithm(SBArenaRef arena,
+    const SBCodepointSequence *codepointSequence, SBBoolean copyString)
 {
     SBUInteger stringLength = codepointSequence->stringLength;
+    SBUInteger stringSize = 0;
     SBAlgorithmRef algorithm;
 
     SB_LOG_BLOCK_OPENER("Algorithm Input");
     SB_LOG_STATEMENT("Codepoints", 1, SB_LOG_CODEPOINT_SEQUENCE(codepointSequence));
     SB_LOG_BLOCK_CLOSER();
 
-    algorithm = AllocateAlgorithm(stringLength);
+    if (copyString) {
+        stringSize = SBCodepointSequenceGetUnitSize(codepointSequence) * stringLength;
+    }
+
+    algorithm = AllocateAlgorithm(arena, stringLength, stringSize);
 
     if (algorithm) {
         algorithm->codepointSequence = *codepointSequence;
+        algorithm->editOffset = 0;
+        algorithm->editLength = stringLength;
         algorithm->retainCount = 1;
 
+        /* Let the algorithm refer to its own copy of the string if it has one. */
+        if (algorithm->fixedString) {
+            memcpy(algorithm->fixedString, codepointSequence->stringBuffer, stringSize);
+            algorithm->codepointSequence.stringBuffer = algorithm->fixedString;
+        }
+
         DetermineBidiTypes(codepointSequence, algorithm->fixedTypes);
 
         SB_LOG_BLOCK_OPENER("Determined Types");
@@ -100,7 +125,188 @@ static SBAlgorithmRef CreateAlgorithm(const SBCodepointSequence *codepointSequen
 SBAlgorithmRef SBAlgorithmCreate(const SBCodepointSequence *codepointSequence)
 {
     if (SBCodepointSequenceIsValid(codepointSequence)) {
-        return CreateAlgorithm(codepointSequence);
+        return CreateAlgorithm(NULL, codepointSequence, SBFalse);
+    }
+
+    return NULL;
+}
+
+SB_INTERNAL SBAlgorithmRef SBAlgorithmCreateWithCopy(const SBCodepointSequence *codepointSequence)
+{
+    return CreateAlgorithm(NULL, codepointSequence, SBTrue);
+}
+
+SBAlgorithmRef SBAlgorithmCreateInArena(SBArenaRef arena, const SBCodepointSequence *codepointSequence)
+{
+    if (SBCodepointSequenceIsValid(codepointSequence)) {
+        return CreateAlgorithm(arena, codepointSequence, SBFalse);
+    }
+
+    return NULL;
+}
+
+SB_INTERNAL void SBAlgorithmInitialize(SBAlgorithmRef algorithm,
+    const SBCodepointSequence *codepointSequence, SBBidiType *types)
+{
+    algorithm->codepointSequence = *codepointSequence;
+    algorithm->fixedString = NULL;
+    algorithm->fixedTypes = types;
+    algorithm->arena = NULL;
+    algorithm->editOffset = 0;
+    algorithm->editLength = codepointSequence->stringLength;
+    algorithm->retainCount = 1;
+
+    DetermineBidiTypes(codepointSequence, types);
+}
+
+static SBUInteger LocateEditStart(const SBBidiType *baseTypes, SBUInteger editOffset)
+{
+    SBUInteger startIndex = editOffset;
+
+    /*
+     * Step back to the first code unit of the code point preceding the edit, so that a code point
+     * split by the edit gets decoded again. Subsequent code units always have 'BN' type.
+     */
+    if (startIndex > 0) {
+        do {
+            startIndex -= 1;
+        } while (startIndex > 0 && baseTypes[startIndex] == SBBidiTypeBN);
+    }
+
+    return startIndex;
+}
+
+static void DetermineVariantBidiTypes(SBAlgorithmRef variant, SBAlgorithmRef base,
+    SBUInteger startIndex, SBUInteger editLimit, SBUInteger baseLimit)
+{
+    const SBCodepointSequence *sequence = &variant->codepointSequence;
+    SBUInteger stringLength = sequence->stringLength;
+    const SBBidiType *baseTypes = base->fixedTypes;
+    SBBidiType *types = variant->fixedTypes;
+    SBUInteger stringIndex = startIndex;
+
+    memcpy(types, baseTypes, sizeof(SBBidiType) * startIndex);
+
+    while (stringIndex < stringLength) {
+        SBUInteger firstIndex = stringIndex;
+        SBCodepoint codepoint;
+
+        /*
+         * Past the edit, stop as soon as a code point starts where the base also had one, since
+         * the rest of the string decodes exactly as before.
+         */
+        if (stringIndex >= editLimit
+            && baseTypes[baseLimit + (stringIndex - editLimit)] != SBBidiTypeBN) {
+            break;
+        }
+
+        codepoint = SBCodepointSequenceGetCodepointAt(sequence, &stringIndex);
+        types[firstIndex] = LookupBidiType(codepoint);
+
+        /* Subsequent code units get 'BN' type. */
+        while (++firstIndex < stringIndex) {
+            types[firstIndex] = SBBidiTypeBN;
+        }
+    }
+
+    if (stringIndex < stringLength) {
+        memcpy(types + stringIndex, baseTypes + baseLimit + (stringIndex - editLimit),
+               sizeof(SBBidiType) * (stringLength - stringIndex));
+    }
+}
+
+static void DetermineEditedRange(SBAlgorithmRef variant, SBUInteger startIndex, SBUInteger editLimit)
+{
+    SBUInteger stringLength = variant->codepointSequence.stringLength;
+    const SBBidiType *types = variant->fixedTypes;
+    SBUInteger paragraphOffset = 0;
+    SBUInteger paragraphLimit;
+    SBUInteger index;
+
+    /* Find the nearest separator ending at or before the start of the edit. */
+    for (index = startIndex; index > 0; index--) {
+        if (types[index - 1] == SBBidiTypeB) {
+            SBUInteger separatorLimit = index - 1 + SBAlgorithmGetSeparatorLength(variant, index - 1);
+
+            if (separatorLimit <= startIndex) {
+                paragraphOffset = separatorLimit;
+                break;
+            }
+        }
+    }
+
+    /*
+     * Extend the range up to the paragraph following the edit if the edit ends at a paragraph
+     * boundary, as it might have split a paragraph of the base.
+     */
+    paragraphLimit = paragraphOffset;
+
+    while (paragraphLimit < stringLength && paragraphLimit <= editLimit) {
+        SBUInteger paragraphLength;
+
+        SBAlgorithmGetParagraphBoundary(variant, paragraphLimit, stringLength - paragraphLimit,
+                                        &paragraphLength, NULL);
+        paragraphLimit += paragraphLength;
+    }
+
+    variant->editOffset = paragraphOffset;
+    variant->editLength = paragraphLimit - paragraphOffset;
+}
+
+SBAlgorithmRef SBAlgorithmCreateVariant(SBAlgorithmRef algorithm,
+    SBUInteger offset, SBUInteger oldLength, const SBCodepointSequence *insertion)
+{
+    const SBCodepointSequence *baseSequence = &algorithm->codepointSequence;
+    SBUInteger baseLength = baseSequence->stringLength;
+    SBUInteger insertLength = 0;
+
+    if (insertion && insertion->stringLength > 0) {
+        if (insertion->stringEncoding != baseSequence->stringEncoding || !insertion->stringBuffer) {
+            return NULL;
+        }
+
+        insertLength = insertion->stringLength;
+    }
+
+    if (offset <= baseLength && oldLength <= baseLength - offset) {
+        SBUInteger stringLength = baseLength - oldLength + insertLength;
+
+        if (stringLength > 0) {
+            SBUInteger unitSize = SBCodepointSequenceGetUnitSize(baseSequence);
+            SBAlgorithmRef variant = AllocateAlgorithm(NULL, stringLength, unitSize * stringLength);
+
+            if (variant) {
+                const SBUInt8 *baseString = (const SBUInt8 *)baseSequence->stringBuffer;
+                SBUInt8 *string = (SBUInt8 *)variant->fixedString;
+                SBUInteger startIndex;
+
+                memcpy(string, baseString, unitSize * offset);
+                if (insertLength > 0) {
+                    memcpy(string + unitSize * offset, insertion->stringBuffer, unitSize * insertLength);
+                }
+                memcpy(string + unitSize * (offset + insertLength),
+                       baseString + unitSize * (offset + oldLength),
+                       unitSize * (baseLength - offset - oldLength));
+
+                variant->codepointSequence.stringEncoding = baseSequence->stringEncoding;
+                variant->codepointSequence.stringBuffer = string;
+                variant->codepointSequence.stringLength = stringLength;
+                variant->retainCount = 1;
+
+                startIndex = LocateEditStart(algorithm->fixedTypes, offset);
+                DetermineVariantBidiTypes(variant, algorithm, startIndex,
+                                          offset + insertLength, offset + oldLength);
+                DetermineEditedRange(variant, startIndex, offset + insertLength);
+
+                SB_LOG_BLOCK_OPENER("Variant Types");
+                SB_LOG_STATEMENT("Types",  1, SB_LOG_BIDI_TYPES_ARRAY(variant->fixedTypes, stringLength));
+                SB_LOG_BLOCK_CLOSER();
+
+                SB_LOG_BREAKER();
+
+                return variant;
+            }
+        }
     }
 
     return NULL;
@@ -111,6 +317,12 @@ const SBBidiType *SBAlgorithmGetBidiTypesPtr(SBAlgorithmRef algorithm)
     return algorithm->fixedTypes;
 }
 
+void SBAlgorithmGetEditedRange(SBAlgorithmRef algorithm, SBUInteger *offset, SBUInteger *length)
+{
+    *offset = algorithm->editOffset;
+    *length = algorithm->editLength;
+}
+
 SB_INTERNAL SBUInteger SBAlgorithmGetSeparatorLength(SBAlgorithmRef algorithm, SBUInteger separatorIndex)
 {
     const SBCodepointSequence *codepointSequence = &algorithm->codepointSequence;
@@ -173,22 +385,101 @@ void SBAlgorithmGetParagraphBoundary(SBAlgorithmRef algorithm,
 
 SBParagraphRef SBAlgorithmCreateParagraph(SBAlgorithmRef algorithm,
     SBUInteger paragraphOffset, SBUInteger suggestedLength, SBLevel baseLevel)
+{
+    return SBAlgorithmCreateParagraphWithLimits(algorithm, paragraphOffset, suggestedLength,
+                                                baseLevel, NULL, NULL);
+}
+
+SBParagraphRef SBAlgorithmCreateParagraphWithLimits(SBAlgorithmRef algorithm,
+    SBUInteger paragraphOffset, SBUInteger suggestedLength, SBLevel baseLevel,
+    const SBResourceLimits *limits, SBResolverStatus *status)
 {
     const SBCodepointSequence *codepointSequence = &algorithm->codepointSequence;
     SBUInteger stringLength = codepointSequence->stringLength;
+    SBResolverStatus resolverStatus = SBResolverStatusFailed;
+    SBParagraphRef paragraph = NULL;
 
     SBUIntegerNormalizeRange(stringLength, &paragraphOffset, &suggestedLength);
 
     if (suggestedLength > 0) {
-        return SBParagraphCreate(algorithm, paragraphOffset, suggestedLength, baseLevel);
+        paragraph = SBParagraphCreate(algorithm, paragraphOffset, suggestedLength, baseLevel,
+                                      limits, &resolverStatus);
+    }
+
+    if (status) {
+        *status = resolverStatus;
+    }
+
+    return paragraph;
+}
+
+SBParagraphRunsRef SBAlgorithmCreateParagraphRuns(SBAlgorithmRef algorithm,
+    SBUInteger paragraphOffset, SBUInteger suggestedLength, SBLevel baseLevel)
+{
+    const SBCodepointSequence *codepointSequence = &algorithm->codepointSequence;
+    SBUInteger stringLength = codepointSequence->stringLength;
+
+    SBUIntegerNormalizeRange(stringLength, &paragraphOffset, &suggestedLength);
+
+    if (suggestedLength > 0) {
+        return SBParagraphRunsCreate(algorithm, paragraphOffset, suggestedLength, baseLevel);
     }
 
     return NULL;
 }
 
+SBBoolean SBAlgorithmCreateParagraphPair(SBAlgorithmRef algorithm,
+    SBUInteger paragraphOffset, SBUInteger suggestedLength,
+    SBParagraphRef *ltrParagraph, SBParagraphRef *rtlParagraph)
+{
+    const SBCodepointSequence *codepointSequence = &algorithm->codepointSequence;
+    SBUInteger stringLength = codepointSequence->stringLength;
+
+    *ltrParagraph = NULL;
+    *rtlParagraph = NULL;
+
+    SBUIntegerNormalizeRange(stringLength, &paragraphOffset, &suggestedLength);
+
+    if (suggestedLength > 0) {
+        return SBParagraphCreatePair(algorithm, paragraphOffset, suggestedLength,
+                                     ltrParagraph, rtlParagraph);
+    }
+
+    return SBFalse;
+}
+
+SBResolverRef SBAlgorithmCreateResolver(SBAlgorithmRef algorithm,
+    SBUInteger paragraphOffset, SBUInteger suggestedLength, SBLevel baseLevel)
+{
+    return SBAlgorithmCreateResolverWithLimits(algorithm, paragraphOffset, suggestedLength,
+                                               baseLevel, NULL);
+}
+
+SBResolverRef SBAlgorithmCreateResolverWithLimits(SBAlgorithmRef algorithm,
+    SBUInteger paragraphOffset, SBUInteger suggestedLength, SBLevel baseLevel,
+    const SBResourceLimits *limits)
+{
+    const SBCodepointSequence *codepointSequence = &algorithm->codepointSequence;
+    SBUInteger stringLength = codepointSequence->stringLength;
+
+    SBUIntegerNormalizeRange(stringLength, &paragraphOffset, &suggestedLength);
+
+    if (suggestedLength > 0) {
+        return SBResolverCreate(algorithm, paragraphOffset, suggestedLength, baseLevel, limits);
+    }
+
+    return NULL;
+}
+
+SBDocumentRef SBAlgorithmResolveAll(SBAlgorithmRef algorithm, SBLevel baseLevel)
+{
+    return SBDocumentCreate(algorithm, baseLevel);
+}
+
 SBAlgorithmRef SBAlgorithmRetain(SBAlgorithmRef algorithm)
 {
-    if (algorithm) {
+    /* The objects of an arena live as long as the arena itself. */
+    if (algorithm && !algorithm->arena) {
         algorithm->retainCount += 1;
     }
 
@@ -197,7 +488,7 @@ SBAlgorithmRef SBAlgorithmRetain(SBAlgorithmRef algorithm)
 
 void SBAlgorithmRelease(SBAlgorithmRef algorithm)
 {
-    if (algorithm && --algorithm->retainCount == 0) {
+    if (algorithm && !algorithm->arena && --algorithm->retainCount == 0) {
         DisposeAlgorithm(algorithm);
     }
 }
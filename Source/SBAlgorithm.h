@@ -18,6 +18,7 @@
 #define _SB_INTERNAL_ALGORITHM_H
 
 #include <SBAlgorithm.h>
+#include <SBArena.h>
 #include <SBBase.h>
 #include <SBBidiType.h>
 #include <SBCodepointSequence.h>
@@ -25,10 +26,17 @@
 
 typedef struct _SBAlgorithm {
     SBCodepointSequence codepointSequence;
+    void *fixedString;
     SBBidiType *fixedTypes;
+    SBArenaRef arena;
+    SBUInteger editOffset;
+    SBUInteger editLength;
     SBUInteger retainCount;
 } SBAlgorithm;
 
+SB_INTERNAL SBAlgorithmRef SBAlgorithmCreateWithCopy(const SBCodepointSequence *codepointSequence);
+SB_INTERNAL void SBAlgorithmInitialize(SBAlgorithmRef algorithm,
+    const SBCodepointSequence *codepointSequence, SBBidiType *types);
 SB_INTERNAL SBUInteger SBAlgorithmGetSeparatorLength(SBAlgorithmRef algorithm, SBUInteger separatorIndex);
 
 #endif
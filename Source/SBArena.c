@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <SBConfig.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "SBBase.h"
+#include "SBArena.h"
+
+#define DefaultBlockSize    16384
+
+typedef union _ArenaAlignment {
+    SBUInteger integer;
+    void *pointer;
+    double real;
+} ArenaAlignment;
+
+static SBUInteger RoundToAlignment(SBUInteger size)
+{
+    const SBUInteger alignment = sizeof(ArenaAlignment);
+
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+static ArenaBlockRef AllocateBlock(SBUInteger capacity)
+{
+    const SBUInteger sizeBlock  = RoundToAlignment(sizeof(ArenaBlock));
+    const SBUInteger sizeMemory = sizeBlock + capacity;
+
+    void *pointer = malloc(sizeMemory);
+
+    if (pointer) {
+        const SBUInteger offsetBlock  = 0;
+        const SBUInteger offsetMemory = offsetBlock + sizeBlock;
+
+        SBUInt8 *memory = (SBUInt8 *)pointer;
+        ArenaBlockRef block = (ArenaBlockRef)(memory + offsetBlock);
+
+        block->next = NULL;
+        block->memory = memory + offsetMemory;
+        block->capacity = capacity;
+        block->used = 0;
+
+        return block;
+    }
+
+    return NULL;
+}
+
+SBArenaRef SBArenaCreate(SBUInteger blockSize)
+{
+    SBArenaRef arena = malloc(sizeof(SBArena));
+
+    if (arena) {
+        arena->firstBlock = NULL;
+        arena->blockSize = RoundToAlignment(blockSize ? blockSize : DefaultBlockSize);
+        arena->allocatedBytes = 0;
+    }
+
+    return arena;
+}
+
+SB_INTERNAL void *SBArenaAllocate(SBArenaRef arena, SBUInteger size)
+{
+    ArenaBlockRef block = arena->firstBlock;
+    void *pointer;
+
+    size = RoundToAlignment(size);
+
+    if (!block || size > block->capacity - block->used) {
+        if (size > arena->blockSize) {
+            /* Give a large object a block of its own and keep filling the current one. */
+            block = AllocateBlock(size);
+
+            if (!block) {
+                return NULL;
+            }
+
+            if (arena->firstBlock) {
+                block->next = arena->firstBlock->next;
+                arena->firstBlock->next = block;
+            } else {
+                arena->firstBlock = block;
+            }
+        } else {
+            block = AllocateBlock(arena->blockSize);
+
+            if (!block) {
+                return NULL;
+            }
+
+            block->next = arena->firstBlock;
+            arena->firstBlock = block;
+        }
+    }
+
+    pointer = block->memory + block->used;
+    block->used += size;
+    arena->allocatedBytes += size;
+
+    return pointer;
+}
+
+SBUInteger SBArenaGetAllocatedBytes(SBArenaRef arena)
+{
+    return arena->allocatedBytes;
+}
+
+void SBArenaDestroy(SBArenaRef arena)
+{
+    if (arena) {
+        ArenaBlockRef block = arena->firstBlock;
+
+        while (block) {
+            ArenaBlockRef next = block->next;
+            free(block);
+            block = next;
+        }
+
+        free(arena);
+    }
+}
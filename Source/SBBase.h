@@ -29,6 +29,18 @@
  */
 #define SBInvalidIndex  (SBUInteger)(-1)
 
+/**
+ * The maximum number of code units of a short paragraph or line, whose working memory is kept in
+ * fixed-size storage on the stack instead of being allocated.
+ */
+#define SBInlineCapacity    64
+
+/**
+ * The offset basis and the prime of 32-bit FNV-1a hash.
+ */
+#define SBHashOffsetBasis   2166136261U
+#define SBHashPrime         16777619U
+
 SB_INTERNAL void SBUIntegerNormalizeRange(SBUInteger actualLength,
     SBUInteger *rangeOffset, SBUInteger *rangeLength);
 
@@ -43,6 +55,13 @@ SB_INTERNAL SBBoolean SBUIntegerVerifyRange(SBUInteger actualLength,
  : (second)                                     \
 )
 
+#define SBNumberGetMin(first, second)           \
+(                                               \
+   (first) < (second)                           \
+ ? (first)                                      \
+ : (second)                                     \
+)
+
 #define SBNumberLimitIncrement(number, limit)   \
 (                                               \
    (number) < (limit)                           \
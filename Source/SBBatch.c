@@ -0,0 +1,264 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <SBConfig.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include <SBBatch.h>
+
+#include "SBAlgorithm.h"
+#include "SBBase.h"
+#include "SBCodepointSequence.h"
+#include "SBLine.h"
+#include "SBLog.h"
+#include "SBParagraph.h"
+
+static SBUInteger AlignSize(SBUInteger size)
+{
+    const SBUInteger alignment = sizeof(SBUInteger);
+
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+static void InitializeResults(SBBatchResults *results)
+{
+    results->entries = NULL;
+    results->levels = NULL;
+    results->runs = NULL;
+    results->entryCount = 0;
+    results->levelCount = 0;
+    results->runCount = 0;
+    results->_memory = NULL;
+}
+
+static SBLevel GetEmptyLevel(SBLevel baseLevel)
+{
+    if (baseLevel == SBLevelDefaultLTR) {
+        return 0;
+    }
+    if (baseLevel == SBLevelDefaultRTL) {
+        return 1;
+    }
+
+    return baseLevel;
+}
+
+static SBBoolean ResolveString(ParagraphContextRef context, SBAlgorithmRef algorithm,
+    SBLevel baseLevel, SBLevel *levels, SBLevel *lineLevels, SBBatchEntry *entry)
+{
+    SBUInteger stringLength = entry->length;
+    SBUInteger paragraphOffset = 0;
+
+    while (paragraphOffset < stringLength) {
+        SBUInteger paragraphLength;
+        SBLevel resolvedLevel;
+
+        SBAlgorithmGetParagraphBoundary(algorithm, paragraphOffset,
+                                        stringLength - paragraphOffset, &paragraphLength, NULL);
+
+        if (!SBParagraphResolveInContext(context, algorithm, paragraphOffset, paragraphLength,
+                                         baseLevel, levels + paragraphOffset, &resolvedLevel)) {
+            return SBFalse;
+        }
+
+        if (paragraphOffset == 0) {
+            entry->baseLevel = resolvedLevel;
+        }
+
+        /* Keep the levels of the line covering the paragraph for writing its runs later. */
+        entry->runCount += SBLineResetLevels(algorithm->fixedTypes + paragraphOffset,
+                                             levels + paragraphOffset, paragraphLength,
+                                             resolvedLevel, lineLevels + paragraphOffset);
+        paragraphOffset += paragraphLength;
+    }
+
+    return SBTrue;
+}
+
+static void WriteRuns(SBAlgorithmRef algorithm, const SBLevel *lineLevels,
+    const SBBatchEntry *entry, SBRun *runs)
+{
+    SBUInteger stringLength = entry->length;
+    SBUInteger paragraphOffset = 0;
+
+    while (paragraphOffset < stringLength) {
+        SBUInteger paragraphLength;
+
+        SBAlgorithmGetParagraphBoundary(algorithm, paragraphOffset,
+                                        stringLength - paragraphOffset, &paragraphLength, NULL);
+
+        runs += SBLineFillRuns(lineLevels + paragraphOffset, paragraphLength, paragraphOffset, runs);
+        paragraphOffset += paragraphLength;
+    }
+}
+
+SBBoolean SBResolveBatch(const SBCodepointSequence *sequences, SBUInteger count,
+    SBLevel baseLevel, SBBatchResults *results)
+{
+    SBUInteger totalLength = 0;
+    SBUInteger maxLength = 0;
+    SBUInteger index;
+
+    InitializeResults(results);
+
+    for (index = 0; index < count; index++) {
+        const SBCodepointSequence *sequence = &sequences[index];
+        SBUInteger stringLength = sequence->stringLength;
+
+        if (stringLength > 0) {
+            if (!SBCodepointSequenceIsValid(sequence)) {
+                return SBFalse;
+            }
+
+            totalLength += stringLength;
+
+            if (stringLength > maxLength) {
+                maxLength = stringLength;
+            }
+        }
+    }
+
+    if (count > 0) {
+        /*
+         * NOTE:
+         *      The number of runs is known only after resolving the strings, so the output is
+         *      allocated without them and extended by the exact size of the runs afterwards. The
+         *      working memory keeps the types and the line levels of all strings until the runs
+         *      have been written.
+         */
+        const SBUInteger sizeEntries    = AlignSize(sizeof(SBBatchEntry) * count);
+        const SBUInteger sizeLevels     = AlignSize(sizeof(SBLevel) * totalLength);
+        const SBUInteger sizeOutput     = sizeEntries + sizeLevels;
+
+        const SBUInteger offsetEntries  = 0;
+        const SBUInteger offsetLevels   = offsetEntries + sizeEntries;
+        const SBUInteger offsetRuns     = offsetLevels + sizeLevels;
+
+        const SBUInteger sizeAlgorithms = sizeof(SBAlgorithm) * count;
+        const SBUInteger sizeTypes      = AlignSize(sizeof(SBBidiType) * totalLength);
+        const SBUInteger sizeLineLevels = AlignSize(sizeof(SBLevel) * totalLength);
+        const SBUInteger sizeContext    = SBParagraphMeasureReusableContext(maxLength);
+        const SBUInteger sizeWorking    = sizeAlgorithms + sizeTypes + sizeLineLevels + sizeContext;
+
+        const SBUInteger offsetAlgorithms = 0;
+        const SBUInteger offsetTypes      = offsetAlgorithms + sizeAlgorithms;
+        const SBUInteger offsetLineLevels = offsetTypes + sizeTypes;
+        const SBUInteger offsetContext    = offsetLineLevels + sizeLineLevels;
+
+        SBUInt8 *memory = (SBUInt8 *)malloc(sizeOutput);
+        SBUInt8 *working = (SBUInt8 *)malloc(sizeWorking);
+        SBBatchEntry *entries;
+        SBLevel *levels;
+        SBAlgorithm *algorithms;
+        SBBidiType *types;
+        SBLevel *lineLevels;
+        ParagraphContextRef context;
+        SBUInteger levelOffset = 0;
+        SBUInteger runOffset = 0;
+        SBBoolean isSucceeded = SBTrue;
+
+        if (!memory || !working) {
+            free(memory);
+            free(working);
+
+            return SBFalse;
+        }
+
+        entries = (SBBatchEntry *)(memory + offsetEntries);
+        levels = (SBLevel *)(memory + offsetLevels);
+        algorithms = (SBAlgorithm *)(working + offsetAlgorithms);
+        types = (SBBidiType *)(working + offsetTypes);
+        lineLevels = (SBLevel *)(working + offsetLineLevels);
+        context = SBParagraphPlaceReusableContext(working + offsetContext, maxLength);
+
+        /* Resolve the levels of all strings and count their runs. */
+        for (index = 0; index < count; index++) {
+            const SBCodepointSequence *sequence = &sequences[index];
+            SBBatchEntry *entry = &entries[index];
+
+            entry->levelOffset = levelOffset;
+            entry->length = sequence->stringLength;
+            entry->runOffset = runOffset;
+            entry->runCount = 0;
+            entry->baseLevel = GetEmptyLevel(baseLevel);
+
+            if (entry->length > 0) {
+                SBAlgorithmInitialize(&algorithms[index], sequence, types + levelOffset);
+
+                if (!ResolveString(context, &algorithms[index], baseLevel,
+                                   levels + levelOffset, lineLevels + levelOffset, entry)) {
+                    isSucceeded = SBFalse;
+                    break;
+                }
+            }
+
+            levelOffset += entry->length;
+            runOffset += entry->runCount;
+        }
+
+        SBParagraphFinalizeReusableContext(context);
+
+        if (isSucceeded) {
+            void *extended = realloc(memory, offsetRuns + sizeof(SBRun) * runOffset);
+
+            if (extended) {
+                SBRun *runs;
+
+                memory = (SBUInt8 *)extended;
+                entries = (SBBatchEntry *)(memory + offsetEntries);
+                runs = (SBRun *)(memory + offsetRuns);
+
+                /* Write the runs of the lines covering each paragraph in visual order. */
+                for (index = 0; index < count; index++) {
+                    const SBBatchEntry *entry = &entries[index];
+
+                    if (entry->length > 0) {
+                        WriteRuns(&algorithms[index], lineLevels + entry->levelOffset,
+                                  entry, runs + entry->runOffset);
+                    }
+                }
+
+                results->entries = entries;
+                results->levels = (const SBLevel *)(memory + offsetLevels);
+                results->runs = runs;
+                results->entryCount = count;
+                results->levelCount = totalLength;
+                results->runCount = runOffset;
+                results->_memory = memory;
+            } else {
+                isSucceeded = SBFalse;
+            }
+        }
+
+        free(working);
+
+        if (!isSucceeded) {
+            SB_LOG_BREAKER();
+            free(memory);
+
+            return SBFalse;
+        }
+    }
+
+    return SBTrue;
+}
+
+void SBBatchResultsFinalize(SBBatchResults *results)
+{
+    free(results->_memory);
+    InitializeResults(results);
+}
@@ -0,0 +1,504 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <SBConfig.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "SBAlgorithm.h"
+#include "SBBase.h"
+#include "SBCodepointSequence.h"
+#include "SBLine.h"
+#include "SBParagraph.h"
+#include "SBCache.h"
+
+#define InitialBucketCount  16
+
+static void LockCache(SBCacheRef cache)
+{
+    if (cache->lock.lock) {
+        cache->lock.lock(cache->lock.object);
+    }
+}
+
+static void UnlockCache(SBCacheRef cache)
+{
+    if (cache->lock.unlock) {
+        cache->lock.unlock(cache->lock.object);
+    }
+}
+
+static SBUInt32 HashString(const SBCodepointSequence *codepointSequence, SBLevel baseLevel)
+{
+    const SBUInt8 *bytes = (const SBUInt8 *)codepointSequence->stringBuffer;
+    SBUInteger byteCount = SBCodepointSequenceGetUnitSize(codepointSequence) * codepointSequence->stringLength;
+    SBUInt32 hash = SBHashOffsetBasis;
+    SBUInteger index;
+
+    /* Apply FNV-1a over the code units, followed by the encoding and the base level. */
+    for (index = 0; index < byteCount; index++) {
+        hash = (hash ^ bytes[index]) * SBHashPrime;
+    }
+
+    hash = (hash ^ codepointSequence->stringEncoding) * SBHashPrime;
+    hash = (hash ^ baseLevel) * SBHashPrime;
+
+    return hash;
+}
+
+static SBBoolean IsEntryMatching(CacheEntryRef entry, SBUInt32 hash,
+    const SBCodepointSequence *codepointSequence, SBLevel baseLevel)
+{
+    const SBCodepointSequence *cachedSequence = &entry->paragraph->algorithm->codepointSequence;
+
+    if (entry->hash == hash && entry->baseLevel == baseLevel
+        && cachedSequence->stringEncoding == codepointSequence->stringEncoding
+        && cachedSequence->stringLength == codepointSequence->stringLength) {
+        SBUInteger byteCount = SBCodepointSequenceGetUnitSize(codepointSequence) * codepointSequence->stringLength;
+
+        return (memcmp(cachedSequence->stringBuffer, codepointSequence->stringBuffer, byteCount) == 0);
+    }
+
+    return SBFalse;
+}
+
+static CacheEntryRef FindEntry(SBCacheRef cache, SBUInt32 hash,
+    const SBCodepointSequence *codepointSequence, SBLevel baseLevel)
+{
+    CacheEntryRef entry = cache->buckets[hash & (cache->bucketCount - 1)];
+
+    while (entry) {
+        if (IsEntryMatching(entry, hash, codepointSequence, baseLevel)) {
+            return entry;
+        }
+
+        entry = entry->chainNext;
+    }
+
+    return NULL;
+}
+
+static void UnlinkEntry(SBCacheRef cache, CacheEntryRef entry)
+{
+    if (entry->newer) {
+        entry->newer->older = entry->older;
+    } else {
+        cache->newest = entry->older;
+    }
+
+    if (entry->older) {
+        entry->older->newer = entry->newer;
+    } else {
+        cache->oldest = entry->newer;
+    }
+}
+
+static void LinkEntry(SBCacheRef cache, CacheEntryRef entry)
+{
+    entry->newer = NULL;
+    entry->older = cache->newest;
+
+    if (cache->newest) {
+        cache->newest->newer = entry;
+    } else {
+        cache->oldest = entry;
+    }
+
+    cache->newest = entry;
+}
+
+static void TouchEntry(SBCacheRef cache, CacheEntryRef entry)
+{
+    if (cache->newest != entry) {
+        UnlinkEntry(cache, entry);
+        LinkEntry(cache, entry);
+    }
+}
+
+static void GrowBuckets(SBCacheRef cache)
+{
+    SBUInteger bucketCount = cache->bucketCount * 2;
+    CacheEntryRef *buckets = malloc(sizeof(CacheEntryRef) * bucketCount);
+    SBUInteger index;
+
+    /* Keep the current buckets if they can't be grown; lookups only become slower. */
+    if (!buckets) {
+        return;
+    }
+
+    for (index = 0; index < bucketCount; index++) {
+        buckets[index] = NULL;
+    }
+
+    for (index = 0; index < cache->bucketCount; index++) {
+        CacheEntryRef entry = cache->buckets[index];
+
+        while (entry) {
+            CacheEntryRef next = entry->chainNext;
+            SBUInteger bucket = entry->hash & (bucketCount - 1);
+
+            entry->chainNext = buckets[bucket];
+            buckets[bucket] = entry;
+
+            entry = next;
+        }
+    }
+
+    free(cache->buckets);
+
+    cache->buckets = buckets;
+    cache->bucketCount = bucketCount;
+}
+
+static SBUInteger MeasureParagraph(SBParagraphRef paragraph)
+{
+    const SBCodepointSequence *codepointSequence = &paragraph->algorithm->codepointSequence;
+    SBUInteger stringLength = codepointSequence->stringLength;
+    SBUInteger stringSize = SBCodepointSequenceGetUnitSize(codepointSequence) * stringLength;
+
+    return sizeof(SBAlgorithm) + stringSize + sizeof(SBBidiType) * stringLength
+         + sizeof(SBParagraph) + sizeof(SBLevel) * (paragraph->length + 2);
+}
+
+static SBUInteger MeasureLine(SBLineRef line)
+{
+    /* The string is shared with the algorithm of the paragraph, which is measured already. */
+    return sizeof(SBLine) + (sizeof(SBRun) + sizeof(SBBoolean)) * line->runCount
+         + (line->length + 7) / 8;
+}
+
+static void RemoveEntry(SBCacheRef cache, CacheEntryRef entry)
+{
+    CacheEntryRef *link = &cache->buckets[entry->hash & (cache->bucketCount - 1)];
+
+    while (*link != entry) {
+        link = &(*link)->chainNext;
+    }
+    *link = entry->chainNext;
+
+    UnlinkEntry(cache, entry);
+
+    cache->entryCount -= 1;
+    cache->usedBytes -= entry->byteCount;
+
+    SBLineRelease(entry->line);
+    SBParagraphRelease(entry->paragraph);
+    free(entry);
+}
+
+static void EvictEntries(SBCacheRef cache)
+{
+    while (cache->usedBytes > cache->byteBudget && cache->oldest) {
+        RemoveEntry(cache, cache->oldest);
+    }
+}
+
+static void InsertEntry(SBCacheRef cache, SBUInt32 hash, SBLevel baseLevel,
+    SBParagraphRef paragraph, SBLineRef line)
+{
+    CacheEntryRef entry = malloc(sizeof(CacheEntry));
+
+    /* Leave the objects uncached if the entry can't be allocated. */
+    if (entry) {
+        SBUInteger bucket;
+
+        if (cache->entryCount >= cache->bucketCount) {
+            GrowBuckets(cache);
+        }
+
+        bucket = hash & (cache->bucketCount - 1);
+
+        entry->chainNext = cache->buckets[bucket];
+        entry->paragraph = SBParagraphRetain(paragraph);
+        entry->line = SBLineRetain(line);
+        entry->hash = hash;
+        entry->byteCount = sizeof(CacheEntry) + MeasureParagraph(paragraph);
+        entry->baseLevel = baseLevel;
+
+        if (line) {
+            entry->byteCount += MeasureLine(line);
+        }
+
+        cache->buckets[bucket] = entry;
+        cache->entryCount += 1;
+        cache->usedBytes += entry->byteCount;
+
+        LinkEntry(cache, entry);
+        EvictEntries(cache);
+    }
+}
+
+static SBParagraphRef ResolveFirstParagraph(const SBCodepointSequence *codepointSequence, SBLevel baseLevel)
+{
+    SBAlgorithmRef algorithm = SBAlgorithmCreateWithCopy(codepointSequence);
+    SBParagraphRef paragraph = NULL;
+
+    if (algorithm) {
+        paragraph = SBAlgorithmCreateParagraph(algorithm, 0, codepointSequence->stringLength, baseLevel);
+        SBAlgorithmRelease(algorithm);
+    }
+
+    return paragraph;
+}
+
+SBCacheRef SBCacheCreate(SBUInteger byteBudget, const SBCacheLock *lock)
+{
+    const SBUInteger sizeCache   = sizeof(SBCache);
+    const SBUInteger sizeBuckets = sizeof(CacheEntryRef) * InitialBucketCount;
+
+    SBCacheRef cache = malloc(sizeCache);
+    CacheEntryRef *buckets = malloc(sizeBuckets);
+
+    if (cache && buckets) {
+        SBUInteger index;
+
+        for (index = 0; index < InitialBucketCount; index++) {
+            buckets[index] = NULL;
+        }
+
+        if (lock) {
+            cache->lock = *lock;
+        } else {
+            cache->lock.object = NULL;
+            cache->lock.lock = NULL;
+            cache->lock.unlock = NULL;
+        }
+
+        cache->buckets = buckets;
+        cache->bucketCount = InitialBucketCount;
+        cache->newest = NULL;
+        cache->oldest = NULL;
+        cache->entryCount = 0;
+        cache->byteBudget = byteBudget;
+        cache->usedBytes = 0;
+        cache->hitCount = 0;
+        cache->missCount = 0;
+        cache->retainCount = 1;
+
+        return cache;
+    }
+
+    free(buckets);
+    free(cache);
+
+    return NULL;
+}
+
+SBParagraphRef SBCacheGetParagraph(SBCacheRef cache,
+    const SBCodepointSequence *codepointSequence, SBLevel baseLevel)
+{
+    SBParagraphRef paragraph = NULL;
+    CacheEntryRef entry;
+    SBUInt32 hash;
+
+    if (!SBCodepointSequenceIsValid(codepointSequence)) {
+        return NULL;
+    }
+
+    hash = HashString(codepointSequence, baseLevel);
+
+    LockCache(cache);
+
+    entry = FindEntry(cache, hash, codepointSequence, baseLevel);
+
+    if (entry) {
+        cache->hitCount += 1;
+        TouchEntry(cache, entry);
+
+        paragraph = SBParagraphRetain(entry->paragraph);
+    }
+
+    UnlockCache(cache);
+
+    if (!entry) {
+        /* Resolve the string outside the lock so that other lookups are not held up. */
+        paragraph = ResolveFirstParagraph(codepointSequence, baseLevel);
+
+        LockCache(cache);
+
+        cache->missCount += 1;
+
+        /* Another thread might have cached the same string in the meantime. */
+        if (paragraph && !FindEntry(cache, hash, codepointSequence, baseLevel)) {
+            InsertEntry(cache, hash, baseLevel, paragraph, NULL);
+        }
+
+        UnlockCache(cache);
+    }
+
+    return paragraph;
+}
+
+SBLineRef SBCacheGetLine(SBCacheRef cache,
+    const SBCodepointSequence *codepointSequence, SBLevel baseLevel)
+{
+    SBParagraphRef paragraph;
+    SBLineRef line = NULL;
+    CacheEntryRef entry;
+    SBUInt32 hash;
+
+    if (!SBCodepointSequenceIsValid(codepointSequence)) {
+        return NULL;
+    }
+
+    hash = HashString(codepointSequence, baseLevel);
+
+    LockCache(cache);
+
+    entry = FindEntry(cache, hash, codepointSequence, baseLevel);
+
+    if (entry) {
+        cache->hitCount += 1;
+        TouchEntry(cache, entry);
+
+        if (entry->line) {
+            line = SBLineRetain(entry->line);
+        } else {
+            /*
+             * The line retains the algorithm of the paragraph, which is shared with other threads,
+             * so create it within the lock.
+             */
+            line = SBLineCreateRetainingString(entry->paragraph, 0, entry->paragraph->length);
+
+            if (line) {
+                SBUInteger byteCount = MeasureLine(line);
+
+                entry->line = SBLineRetain(line);
+                entry->byteCount += byteCount;
+                cache->usedBytes += byteCount;
+
+                EvictEntries(cache);
+            }
+        }
+
+        UnlockCache(cache);
+
+        return line;
+    }
+
+    UnlockCache(cache);
+
+    /* Resolve the string into objects that no other thread can reach until they are cached. */
+    paragraph = ResolveFirstParagraph(codepointSequence, baseLevel);
+
+    if (paragraph) {
+        line = SBLineCreateRetainingString(paragraph, 0, paragraph->length);
+    }
+
+    LockCache(cache);
+
+    cache->missCount += 1;
+
+    /* Leave the objects uncached if another thread has cached the string meanwhile. */
+    if (line && !FindEntry(cache, hash, codepointSequence, baseLevel)) {
+        InsertEntry(cache, hash, baseLevel, paragraph, line);
+    }
+
+    /* The paragraph may be shared with other threads now, so release it within the lock. */
+    SBParagraphRelease(paragraph);
+
+    UnlockCache(cache);
+
+    return line;
+}
+
+void SBCacheReleaseParagraph(SBCacheRef cache, SBParagraphRef paragraph)
+{
+    LockCache(cache);
+    SBParagraphRelease(paragraph);
+    UnlockCache(cache);
+}
+
+void SBCacheReleaseLine(SBCacheRef cache, SBLineRef line)
+{
+    LockCache(cache);
+    SBLineRelease(line);
+    UnlockCache(cache);
+}
+
+SBUInteger SBCacheGetHitCount(SBCacheRef cache)
+{
+    SBUInteger hitCount;
+
+    LockCache(cache);
+    hitCount = cache->hitCount;
+    UnlockCache(cache);
+
+    return hitCount;
+}
+
+SBUInteger SBCacheGetMissCount(SBCacheRef cache)
+{
+    SBUInteger missCount;
+
+    LockCache(cache);
+    missCount = cache->missCount;
+    UnlockCache(cache);
+
+    return missCount;
+}
+
+SBUInteger SBCacheGetEntryCount(SBCacheRef cache)
+{
+    SBUInteger entryCount;
+
+    LockCache(cache);
+    entryCount = cache->entryCount;
+    UnlockCache(cache);
+
+    return entryCount;
+}
+
+SBUInteger SBCacheGetUsedBytes(SBCacheRef cache)
+{
+    SBUInteger usedBytes;
+
+    LockCache(cache);
+    usedBytes = cache->usedBytes;
+    UnlockCache(cache);
+
+    return usedBytes;
+}
+
+void SBCacheClear(SBCacheRef cache)
+{
+    LockCache(cache);
+
+    while (cache->oldest) {
+        RemoveEntry(cache, cache->oldest);
+    }
+
+    UnlockCache(cache);
+}
+
+SBCacheRef SBCacheRetain(SBCacheRef cache)
+{
+    if (cache) {
+        cache->retainCount += 1;
+    }
+
+    return cache;
+}
+
+void SBCacheRelease(SBCacheRef cache)
+{
+    if (cache && --cache->retainCount == 0) {
+        SBCacheClear(cache);
+        free(cache->buckets);
+        free(cache);
+    }
+}
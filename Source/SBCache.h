@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _SB_INTERNAL_CACHE_H
+#define _SB_INTERNAL_CACHE_H
+
+#include <SBBase.h>
+#include <SBCache.h>
+#include <SBConfig.h>
+#include <SBLine.h>
+#include <SBParagraph.h>
+
+typedef struct _CacheEntry {
+    struct _CacheEntry *chainNext;
+    struct _CacheEntry *newer;
+    struct _CacheEntry *older;
+    SBParagraphRef paragraph;
+    SBLineRef line;
+    SBUInt32 hash;
+    SBUInteger byteCount;
+    SBLevel baseLevel;
+} CacheEntry, *CacheEntryRef;
+
+typedef struct _SBCache {
+    SBCacheLock lock;
+    CacheEntryRef *buckets;
+    SBUInteger bucketCount;
+    CacheEntryRef newest;
+    CacheEntryRef oldest;
+    SBUInteger entryCount;
+    SBUInteger byteBudget;
+    SBUInteger usedBytes;
+    SBUInteger hitCount;
+    SBUInteger missCount;
+    SBUInteger retainCount;
+} SBCache;
+
+#endif
@@ -99,6 +99,85 @@ SB_INTERNAL SBBoolean SBCodepointSequenceIsValid(const SBCodepointSequence *code
     return SBFalse;
 }
 
+SB_INTERNAL SBUInteger SBCodepointSequenceGetUnitSize(const SBCodepointSequence *codepointSequence)
+{
+    switch (codepointSequence->stringEncoding) {
+    case SBStringEncodingUTF16:
+        return sizeof(SBUInt16);
+
+    case SBStringEncodingUTF32:
+        return sizeof(SBUInt32);
+
+    default:
+        return sizeof(SBUInt8);
+    }
+}
+
+SB_INTERNAL SBUInteger SBCodepointEncode(SBCodepoint codepoint, SBStringEncoding encoding,
+    void *buffer, SBUInteger stringIndex)
+{
+    switch (encoding) {
+    case SBStringEncodingUTF8:
+        if (codepoint < 0x80) {
+            if (buffer) {
+                SBUInt8 *units = (SBUInt8 *)buffer + stringIndex;
+                units[0] = (SBUInt8)codepoint;
+            }
+            return 1;
+        }
+        if (codepoint < 0x800) {
+            if (buffer) {
+                SBUInt8 *units = (SBUInt8 *)buffer + stringIndex;
+                units[0] = (SBUInt8)(0xC0 | (codepoint >> 6));
+                units[1] = (SBUInt8)(0x80 | (codepoint & 0x3F));
+            }
+            return 2;
+        }
+        if (codepoint < 0x10000) {
+            if (buffer) {
+                SBUInt8 *units = (SBUInt8 *)buffer + stringIndex;
+                units[0] = (SBUInt8)(0xE0 | (codepoint >> 12));
+                units[1] = (SBUInt8)(0x80 | ((codepoint >> 6) & 0x3F));
+                units[2] = (SBUInt8)(0x80 | (codepoint & 0x3F));
+            }
+            return 3;
+        }
+        if (buffer) {
+            SBUInt8 *units = (SBUInt8 *)buffer + stringIndex;
+            units[0] = (SBUInt8)(0xF0 | (codepoint >> 18));
+            units[1] = (SBUInt8)(0x80 | ((codepoint >> 12) & 0x3F));
+            units[2] = (SBUInt8)(0x80 | ((codepoint >> 6) & 0x3F));
+            units[3] = (SBUInt8)(0x80 | (codepoint & 0x3F));
+        }
+        return 4;
+
+    case SBStringEncodingUTF16:
+        if (codepoint < 0x10000) {
+            if (buffer) {
+                SBUInt16 *units = (SBUInt16 *)buffer + stringIndex;
+                units[0] = (SBUInt16)codepoint;
+            }
+            return 1;
+        }
+        if (buffer) {
+            SBUInt16 *units = (SBUInt16 *)buffer + stringIndex;
+            codepoint -= 0x10000;
+            units[0] = (SBUInt16)(0xD800 | (codepoint >> 10));
+            units[1] = (SBUInt16)(0xDC00 | (codepoint & 0x3FF));
+        }
+        return 2;
+
+    case SBStringEncodingUTF32:
+        if (buffer) {
+            SBUInt32 *units = (SBUInt32 *)buffer + stringIndex;
+            units[0] = codepoint;
+        }
+        return 1;
+    }
+
+    return 0;
+}
+
 SBCodepoint SBCodepointSequenceGetCodepointBefore(const SBCodepointSequence *codepointSequence, SBUInteger *stringIndex)
 {
     SBCodepoint codepoint = SBCodepointInvalid;
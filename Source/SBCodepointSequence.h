@@ -21,5 +21,8 @@
 #include <SBCodepointSequence.h>
 
 SB_INTERNAL SBBoolean SBCodepointSequenceIsValid(const SBCodepointSequence *codepointSequence);
+SB_INTERNAL SBUInteger SBCodepointSequenceGetUnitSize(const SBCodepointSequence *codepointSequence);
+SB_INTERNAL SBUInteger SBCodepointEncode(SBCodepoint codepoint, SBStringEncoding encoding,
+    void *buffer, SBUInteger stringIndex);
 
 #endif
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <SBConfig.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "SBAlgorithm.h"
+#include "SBBase.h"
+#include "SBLog.h"
+#include "SBParagraph.h"
+#include "SBDocument.h"
+
+#define InitialParagraphCapacity 8
+
+static SBUInteger MeasureDocument(SBUInteger paragraphCapacity, SBUInteger length)
+{
+    const SBUInteger sizeDocument   = sizeof(SBDocument);
+    const SBUInteger sizeParagraphs = sizeof(SBParagraphInfo) * paragraphCapacity;
+    const SBUInteger sizeLevels     = sizeof(SBLevel) * length;
+
+    return sizeDocument + sizeParagraphs + sizeLevels;
+}
+
+static SBDocumentRef PlaceDocument(void *pointer, SBUInteger paragraphCapacity, SBUInteger length)
+{
+    const SBUInteger offsetDocument   = 0;
+    const SBUInteger offsetParagraphs = offsetDocument + sizeof(SBDocument);
+    const SBUInteger offsetLevels     = offsetParagraphs + sizeof(SBParagraphInfo) * paragraphCapacity;
+
+    SBUInt8 *memory = (SBUInt8 *)pointer;
+    SBDocumentRef document = (SBDocumentRef)(memory + offsetDocument);
+
+    document->fixedParagraphs = (SBParagraphInfo *)(memory + offsetParagraphs);
+    document->fixedLevels = (SBLevel *)(memory + offsetLevels);
+    document->length = length;
+
+    return document;
+}
+
+static void DisposeDocument(SBDocumentRef document)
+{
+    free(document);
+}
+
+/*
+ * Allocates a document and fills its paragraph table in a single walk over the paragraph
+ * boundaries. The table grows along with the walk; as the levels follow it in memory and are not
+ * written yet, growing it does not need to preserve them.
+ */
+static SBDocumentRef CreateParagraphTable(SBAlgorithmRef algorithm, SBUInteger *maxLength)
+{
+    SBUInteger stringLength = algorithm->codepointSequence.stringLength;
+    SBUInteger paragraphCapacity = InitialParagraphCapacity;
+    SBUInteger paragraphOffset = 0;
+    SBUInteger paragraphCount = 0;
+    SBDocumentRef document;
+    void *pointer;
+
+    pointer = malloc(MeasureDocument(paragraphCapacity, stringLength));
+
+    if (!pointer) {
+        return NULL;
+    }
+
+    document = PlaceDocument(pointer, paragraphCapacity, stringLength);
+    *maxLength = 0;
+
+    while (paragraphOffset < stringLength) {
+        SBParagraphInfo *info;
+
+        if (paragraphCount == paragraphCapacity) {
+            paragraphCapacity *= 2;
+            pointer = realloc(document, MeasureDocument(paragraphCapacity, stringLength));
+
+            if (!pointer) {
+                DisposeDocument(document);
+                return NULL;
+            }
+
+            document = PlaceDocument(pointer, paragraphCapacity, stringLength);
+        }
+
+        info = &document->fixedParagraphs[paragraphCount];
+        info->offset = paragraphOffset;
+
+        SBAlgorithmGetParagraphBoundary(algorithm, paragraphOffset, stringLength - paragraphOffset,
+                                        &info->length, NULL);
+
+        if (info->length > *maxLength) {
+            *maxLength = info->length;
+        }
+
+        paragraphOffset += info->length;
+        paragraphCount += 1;
+    }
+
+    document->paragraphCount = paragraphCount;
+
+    return document;
+}
+
+SB_INTERNAL SBDocumentRef SBDocumentCreate(SBAlgorithmRef algorithm, SBLevel baseLevel)
+{
+    SBUInteger maxLength;
+    SBDocumentRef document;
+
+    /* Locate all paragraphs up front so that a single context fits each of them. */
+    document = CreateParagraphTable(algorithm, &maxLength);
+
+    if (document) {
+        ParagraphContextRef context = SBParagraphCreateReusableContext(maxLength);
+
+        if (context) {
+            SBParagraphInfo *paragraphs = document->fixedParagraphs;
+            SBUInteger index;
+
+            for (index = 0; index < document->paragraphCount; index++) {
+                SBParagraphInfo *info = &paragraphs[index];
+
+                if (!SBParagraphResolveInContext(context, algorithm, info->offset, info->length,
+                                                 baseLevel, document->fixedLevels + info->offset,
+                                                 &info->baseLevel)) {
+                    break;
+                }
+            }
+
+            SBParagraphDisposeContext(context);
+
+            if (index == document->paragraphCount) {
+                document->retainCount = 1;
+                return document;
+            }
+        }
+
+        DisposeDocument(document);
+    }
+
+    SB_LOG_BREAKER();
+
+    return NULL;
+}
+
+SBUInteger SBDocumentGetLength(SBDocumentRef document)
+{
+    return document->length;
+}
+
+SBUInteger SBDocumentGetParagraphCount(SBDocumentRef document)
+{
+    return document->paragraphCount;
+}
+
+const SBParagraphInfo *SBDocumentGetParagraphsPtr(SBDocumentRef document)
+{
+    return document->fixedParagraphs;
+}
+
+const SBLevel *SBDocumentGetLevelsPtr(SBDocumentRef document)
+{
+    return document->fixedLevels;
+}
+
+SBDocumentRef SBDocumentRetain(SBDocumentRef document)
+{
+    if (document) {
+        document->retainCount += 1;
+    }
+
+    return document;
+}
+
+void SBDocumentRelease(SBDocumentRef document)
+{
+    if (document && --document->retainCount == 0) {
+        DisposeDocument(document);
+    }
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <SBConfig.h>
+#include <stddef.h>
+
+#include "SBBase.h"
+#include "SBExecutor.h"
+
+static SBBoolean IsExecutorUsable(const SBExecutor *executor)
+{
+    return (executor && executor->concurrency > 1 && executor->submit && executor->wait);
+}
+
+SB_INTERNAL SBUInteger SBExecutorGetTaskCount(const SBExecutor *executor, SBUInteger workCount)
+{
+    if (IsExecutorUsable(executor) && workCount > 1) {
+        if (workCount < executor->concurrency) {
+            return workCount;
+        }
+
+        return executor->concurrency;
+    }
+
+    return 1;
+}
+
+SB_INTERNAL void SBExecutorSubmitTask(const SBExecutor *executor,
+    SBExecutorTaskFunc task, void *data)
+{
+    if (IsExecutorUsable(executor)) {
+        executor->submit(executor->object, task, data);
+    } else {
+        /* Run the task in place if there is no executor to hand it over. */
+        task(data);
+    }
+}
+
+SB_INTERNAL void SBExecutorWaitTasks(const SBExecutor *executor)
+{
+    if (IsExecutorUsable(executor)) {
+        executor->wait(executor->object);
+    }
+}
@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <SBConfig.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "SBBase.h"
+#include "SBLine.h"
+#include "SBHitIndex.h"
+
+static void FillHitIndex(SBHitIndexRef hitIndex, SBLineRef line, const SBInteger *advances)
+{
+    SBUInteger visualIndex = 0;
+    SBInteger position = 0;
+    SBUInteger runIndex;
+
+    hitIndex->positions[0] = 0;
+
+    for (runIndex = 0; runIndex < line->runCount; runIndex++) {
+        const SBRun *run = &line->fixedRuns[runIndex];
+        SBUInteger unitIndex = run->offset - line->offset;
+        SBUInteger unitLimit = unitIndex + run->length;
+        SBBoolean isReversed = (run->level & 1);
+
+        while (unitIndex < unitLimit) {
+            SBUInteger logicalIndex = (isReversed ? --unitLimit : unitIndex++);
+
+            position += advances[logicalIndex];
+
+            hitIndex->logicalIndexes[visualIndex] = logicalIndex;
+            hitIndex->visualIndexes[logicalIndex] = visualIndex;
+            hitIndex->levels[visualIndex] = run->level;
+            hitIndex->positions[++visualIndex] = position;
+        }
+    }
+}
+
+SBHitIndexRef SBHitIndexCreate(SBLineRef line, const SBInteger *advances)
+{
+    const SBUInteger length = line->length;
+
+    const SBUInteger sizeIndex          = sizeof(SBHitIndex);
+    const SBUInteger sizePositions      = sizeof(SBInteger) * (length + 1);
+    const SBUInteger sizeLogicalIndexes = sizeof(SBUInteger) * length;
+    const SBUInteger sizeVisualIndexes  = sizeof(SBUInteger) * length;
+    const SBUInteger sizeLevels         = sizeof(SBLevel) * length;
+    const SBUInteger sizeMemory         = sizeIndex + sizePositions + sizeLogicalIndexes
+                                        + sizeVisualIndexes + sizeLevels;
+
+    const SBUInteger offsetIndex          = 0;
+    const SBUInteger offsetPositions      = offsetIndex + sizeIndex;
+    const SBUInteger offsetLogicalIndexes = offsetPositions + sizePositions;
+    const SBUInteger offsetVisualIndexes  = offsetLogicalIndexes + sizeLogicalIndexes;
+    const SBUInteger offsetLevels         = offsetVisualIndexes + sizeVisualIndexes;
+
+    SBUInt8 *memory = (SBUInt8 *)malloc(sizeMemory);
+
+    if (memory) {
+        SBHitIndexRef hitIndex = (SBHitIndexRef)(memory + offsetIndex);
+
+        hitIndex->positions = (SBInteger *)(memory + offsetPositions);
+        hitIndex->logicalIndexes = (SBUInteger *)(memory + offsetLogicalIndexes);
+        hitIndex->visualIndexes = (SBUInteger *)(memory + offsetVisualIndexes);
+        hitIndex->levels = (SBLevel *)(memory + offsetLevels);
+        hitIndex->offset = line->offset;
+        hitIndex->length = length;
+        hitIndex->retainCount = 1;
+
+        FillHitIndex(hitIndex, line, advances);
+
+        return hitIndex;
+    }
+
+    return NULL;
+}
+
+SBInteger SBHitIndexGetWidth(SBHitIndexRef hitIndex)
+{
+    return hitIndex->positions[hitIndex->length];
+}
+
+SBUInteger SBHitIndexGetOffsetAtPosition(SBHitIndexRef hitIndex,
+    SBInteger position, SBBoolean *isTrailing)
+{
+    const SBInteger *positions = hitIndex->positions;
+    SBUInteger visualIndex = 0;
+    SBBoolean isRightHalf = SBFalse;
+
+    if (hitIndex->length > 0) {
+        SBUInteger low = 1;
+        SBUInteger high = hitIndex->length;
+
+        /* Find the last code unit starting at or before the position. */
+        while (low < high) {
+            SBUInteger mid = low + (high - low) / 2;
+
+            if (positions[mid] <= position) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+
+        visualIndex = low - 1;
+
+        /*
+         * A position beyond an edge falls on the outermost code unit even if it has no advance,
+         * such as the trailing unit of a code point, so move inwards to one that has.
+         */
+        if (positions[visualIndex] == positions[visualIndex + 1]) {
+            if (position < positions[0]) {
+                while (visualIndex + 1 < hitIndex->length
+                       && positions[visualIndex] == positions[visualIndex + 1]) {
+                    visualIndex += 1;
+                }
+            } else {
+                while (visualIndex > 0 && positions[visualIndex] == positions[visualIndex + 1]) {
+                    visualIndex -= 1;
+                }
+            }
+        }
+
+        isRightHalf = (position - positions[visualIndex] >= positions[visualIndex + 1] - position);
+    }
+
+    if (isTrailing) {
+        if (hitIndex->length > 0 && (hitIndex->levels[visualIndex] & 1)) {
+            *isTrailing = !isRightHalf;
+        } else {
+            *isTrailing = isRightHalf;
+        }
+    }
+
+    if (hitIndex->length == 0) {
+        return hitIndex->offset;
+    }
+
+    return hitIndex->offset + hitIndex->logicalIndexes[visualIndex];
+}
+
+SBInteger SBHitIndexGetCaretPosition(SBHitIndexRef hitIndex, SBUInteger offset)
+{
+    SBUInteger length = hitIndex->length;
+    SBUInteger logicalIndex;
+    SBUInteger visualIndex;
+    SBBoolean isLeftEdge;
+
+    if (length == 0) {
+        return 0;
+    }
+
+    if (offset < hitIndex->offset) {
+        offset = hitIndex->offset;
+    }
+
+    logicalIndex = offset - hitIndex->offset;
+
+    if (logicalIndex < length) {
+        visualIndex = hitIndex->visualIndexes[logicalIndex];
+        /* The leading edge of a code unit is its left edge in a left-to-right run. */
+        isLeftEdge = !(hitIndex->levels[visualIndex] & 1);
+    } else {
+        visualIndex = hitIndex->visualIndexes[length - 1];
+        /* The trailing edge of a code unit is its right edge in a left-to-right run. */
+        isLeftEdge = (hitIndex->levels[visualIndex] & 1);
+    }
+
+    return hitIndex->positions[isLeftEdge ? visualIndex : visualIndex + 1];
+}
+
+SBHitIndexRef SBHitIndexRetain(SBHitIndexRef hitIndex)
+{
+    if (hitIndex) {
+        hitIndex->retainCount += 1;
+    }
+
+    return hitIndex;
+}
+
+void SBHitIndexRelease(SBHitIndexRef hitIndex)
+{
+    if (hitIndex && --hitIndex->retainCount == 0) {
+        free(hitIndex);
+    }
+}
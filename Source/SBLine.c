@@ -17,9 +17,11 @@
 #include <SBConfig.h>
 #include <stddef.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "PairingLookup.h"
 #include "SBAlgorithm.h"
+#include "SBArena.h"
 #include "SBAssert.h"
 #include "SBBase.h"
 #include "SBCodepointSequence.h"
@@ -32,8 +34,14 @@ typedef struct _LineContext {
     SBLevel *fixedLevels;
     SBUInteger runCount;
     SBLevel maxLevel;
+    SBBoolean isAllocated;
 } LineContext, *LineContextRef;
 
+typedef struct _InlineLineContext {
+    LineContext context;
+    SBLevel levels[SBInlineCapacity];
+} InlineLineContext;
+
 static SBLevel CopyLevels(SBLevel *destination,
     const SBLevel *source, SBUInteger length, SBUInteger *runCount)
 {
@@ -59,13 +67,31 @@ static SBLevel CopyLevels(SBLevel *destination,
     return maxLevel;
 }
 
-static LineContextRef CreateLineContext(const SBBidiType *types, const SBLevel *levels, SBUInteger length)
+static void InitializeLineContext(LineContextRef context, SBLevel *fixedLevels,
+    const SBBidiType *types, const SBLevel *levels, SBUInteger length)
+{
+    context->refTypes = types;
+    context->fixedLevels = fixedLevels;
+    context->maxLevel = CopyLevels(fixedLevels, levels, length, &context->runCount);
+    context->isAllocated = SBFalse;
+}
+
+static LineContextRef CreateLineContext(const SBBidiType *types, const SBLevel *levels,
+    SBUInteger length, InlineLineContext *storage)
 {
     const SBUInteger sizeContext = sizeof(LineContext);
     const SBUInteger sizeLevels  = sizeof(SBLevel) * length;
     const SBUInteger sizeMemory  = sizeContext + sizeLevels;
 
-    void *pointer = malloc(sizeMemory);
+    void *pointer;
+
+    /* Keep the context of a short line in the given storage rather than allocating it. */
+    if (length <= SBInlineCapacity) {
+        InitializeLineContext(&storage->context, storage->levels, types, levels, length);
+        return &storage->context;
+    }
+
+    pointer = malloc(sizeMemory);
 
     if (pointer) {
         const SBUInteger offsetContext = 0;
@@ -75,9 +101,8 @@ static LineContextRef CreateLineContext(const SBBidiType *types, const SBLevel *
         LineContextRef context = (LineContextRef)(memory + offsetContext);
         SBLevel *fixedLevels = (SBLevel *)(memory + offsetLevels);
 
-        context->refTypes = types;
-        context->fixedLevels = fixedLevels;
-        context->maxLevel = CopyLevels(fixedLevels, levels, length, &context->runCount);
+        InitializeLineContext(context, fixedLevels, types, levels, length);
+        context->isAllocated = SBTrue;
 
         return context;
     }
@@ -87,26 +112,41 @@ static LineContextRef CreateLineContext(const SBBidiType *types, const SBLevel *
 
 static void DisposeLineContext(LineContextRef context)
 {
-    free(context);
+    if (context->isAllocated) {
+        free(context);
+    }
+}
+
+static SBUInteger GetMirrorUnitsSize(SBUInteger lineLength)
+{
+    return (lineLength + 7) / 8;
 }
 
-static SBLineRef AllocateLine(SBUInteger runCount)
+static SBLineRef AllocateLine(SBArenaRef arena, SBUInteger runCount, SBUInteger lineLength)
 {
-    const SBUInteger sizeLine   = sizeof(SBLine);
-    const SBUInteger sizeRuns   = sizeof(SBRun) * runCount;
-    const SBUInteger sizeMemory = sizeLine + sizeRuns;
+    const SBUInteger sizeLine        = sizeof(SBLine);
+    const SBUInteger sizeRuns        = sizeof(SBRun) * runCount;
+    const SBUInteger sizeMirrorRuns  = sizeof(SBBoolean) * runCount;
+    const SBUInteger sizeMirrorUnits = GetMirrorUnitsSize(lineLength);
+    const SBUInteger sizeMemory      = sizeLine + sizeRuns + sizeMirrorRuns + sizeMirrorUnits;
 
-    void *pointer = malloc(sizeMemory);
+    void *pointer = (arena ? SBArenaAllocate(arena, sizeMemory) : malloc(sizeMemory));
 
     if (pointer) {
-        const SBUInteger offsetLine = 0;
-        const SBUInteger offsetRuns = offsetLine + sizeLine;
+        const SBUInteger offsetLine        = 0;
+        const SBUInteger offsetRuns        = offsetLine + sizeLine;
+        const SBUInteger offsetMirrorRuns  = offsetRuns + sizeRuns;
+        const SBUInteger offsetMirrorUnits = offsetMirrorRuns + sizeMirrorRuns;
 
         SBUInt8 *memory = (SBUInt8 *)pointer;
         SBLineRef line = (SBLineRef)(memory + offsetLine);
         SBRun *runs = (SBRun *)(memory + offsetRuns);
 
         line->fixedRuns = runs;
+        line->fixedMirrorRuns = (SBBoolean *)(memory + offsetMirrorRuns);
+        line->fixedMirrorUnits = memory + offsetMirrorUnits;
+        line->retainedAlgorithm = NULL;
+        line->arena = arena;
 
         return line;
     }
@@ -123,7 +163,8 @@ static void SetNewLevel(SBLevel *levels, SBUInteger length, SBLevel newLevel)
     }
 }
 
-static void ResetLevels(LineContextRef context, SBLevel baseLevel, SBUInteger charCount)
+static void ResetLevels(LineContextRef context, SBLevel baseLevel, SBUInteger charCount,
+    SBBoolean resetsTrailing)
 {
     const SBBidiType *types = context->refTypes;
     SBLevel *levels = context->fixedLevels;
@@ -133,7 +174,7 @@ static void ResetLevels(LineContextRef context, SBLevel baseLevel, SBUInteger ch
 
     index = charCount;
     length = 0;
-    reset = SBTrue;
+    reset = resetsTrailing;
 
     while (index--) {
         SBBidiType type = types[index];
@@ -244,12 +285,88 @@ static void ReorderRuns(SBRun *runs, SBUInteger runCount, SBLevel maxLevel)
     }
 }
 
-SB_INTERNAL SBLineRef SBLineCreate(SBParagraphRef paragraph,
-    SBUInteger lineOffset, SBUInteger lineLength)
+static SBUInteger CountRuns(const SBLevel *levels, SBUInteger length)
+{
+    SBUInteger runCount = 1;
+    SBUInteger index;
+
+    for (index = 1; index < length; index++) {
+        if (levels[index] != levels[index - 1]) {
+            runCount += 1;
+        }
+    }
+
+    return runCount;
+}
+
+SB_INTERNAL SBUInteger SBLineResetLevels(const SBBidiType *types, const SBLevel *levels,
+    SBUInteger length, SBLevel baseLevel, SBLevel *lineLevels)
+{
+    LineContext context;
+
+    InitializeLineContext(&context, lineLevels, types, levels, length);
+    ResetLevels(&context, baseLevel, length, SBTrue);
+
+    return CountRuns(lineLevels, length);
+}
+
+SB_INTERNAL SBUInteger SBLineFillRuns(const SBLevel *lineLevels, SBUInteger length,
+    SBUInteger lineOffset, SBRun *runs)
+{
+    SBUInteger runCount = InitializeRuns(runs, lineLevels, length, lineOffset);
+    SBLevel maxLevel = 0;
+    SBUInteger runIndex;
+
+    for (runIndex = 0; runIndex < runCount; runIndex++) {
+        if (runs[runIndex].level > maxLevel) {
+            maxLevel = runs[runIndex].level;
+        }
+    }
+
+    ReorderRuns(runs, runCount, maxLevel);
+
+    return runCount;
+}
+
+static void MarkMirrorCandidates(SBLineRef line, const SBBidiType *types)
+{
+    SBUInt8 *mirrorUnits = line->fixedMirrorUnits;
+    SBUInteger runIndex;
+
+    memset(mirrorUnits, 0, GetMirrorUnitsSize(line->length));
+
+    /*
+     * Only the code points of right-to-left runs get mirrored, and every mirrorable code point has
+     * 'ON' type, so mark the code units having this type in such runs.
+     */
+    for (runIndex = 0; runIndex < line->runCount; runIndex++) {
+        const SBRun *run = &line->fixedRuns[runIndex];
+        SBBoolean mayMirror = SBFalse;
+
+        if (run->level & 1) {
+            SBUInteger unitIndex = run->offset - line->offset;
+            SBUInteger unitLimit = unitIndex + run->length;
+
+            for (; unitIndex < unitLimit; unitIndex++) {
+                if (types[unitIndex] == SBBidiTypeON) {
+                    mirrorUnits[unitIndex >> 3] |= (SBUInt8)(1 << (unitIndex & 7));
+                    mayMirror = SBTrue;
+                }
+            }
+        }
+
+        line->fixedMirrorRuns[runIndex] = mayMirror;
+    }
+}
+
+static SBLineRef CreateLine(SBParagraphRef paragraph,
+    SBUInteger lineOffset, SBUInteger lineLength, SBBoolean retainsString)
 {
+    const SBCodepointSequence *codepointSequence = &paragraph->algorithm->codepointSequence;
     SBUInteger innerOffset = lineOffset - paragraph->offset;
     const SBBidiType *refTypes = paragraph->refTypes + innerOffset;
     const SBLevel *refLevels = paragraph->fixedLevels + innerOffset;
+    InlineLineContext storage;
     LineContextRef context;
     SBLineRef line;
 
@@ -258,21 +375,28 @@ SB_INTERNAL SBLineRef SBLineCreate(SBParagraphRef paragraph,
              && lineOffset >= paragraph->offset
              && (lineOffset + lineLength) <= (paragraph->offset + paragraph->length));
 
-    context = CreateLineContext(refTypes, refLevels, lineLength);
+    context = CreateLineContext(refTypes, refLevels, lineLength, &storage);
 
     if (context) {
-        ResetLevels(context, paragraph->baseLevel, lineLength);
+        ResetLevels(context, paragraph->baseLevel, lineLength, SBTrue);
 
-        line = AllocateLine(context->runCount);
+        line = AllocateLine(paragraph->arena, context->runCount, lineLength);
 
         if (line) {
             line->runCount = InitializeRuns(line->fixedRuns, context->fixedLevels, lineLength, lineOffset);
             ReorderRuns(line->fixedRuns, line->runCount, context->maxLevel);
 
-            line->codepointSequence = paragraph->algorithm->codepointSequence;
+            line->codepointSequence = *codepointSequence;
             line->offset = lineOffset;
             line->length = lineLength;
             line->retainCount = 1;
+
+            MarkMirrorCandidates(line, refTypes);
+
+            /* Keep the string of the algorithm alive for as long as the line refers to it. */
+            if (retainsString) {
+                line->retainedAlgorithm = SBAlgorithmRetain(paragraph->algorithm);
+            }
         }
 
         DisposeLineContext(context);
@@ -283,6 +407,190 @@ SB_INTERNAL SBLineRef SBLineCreate(SBParagraphRef paragraph,
     return NULL;
 }
 
+SB_INTERNAL SBLineRef SBLineCreate(SBParagraphRef paragraph,
+    SBUInteger lineOffset, SBUInteger lineLength)
+{
+    return CreateLine(paragraph, lineOffset, lineLength, SBFalse);
+}
+
+SB_INTERNAL SBLineRef SBLineCreateRetainingString(SBParagraphRef paragraph,
+    SBUInteger lineOffset, SBUInteger lineLength)
+{
+    return CreateLine(paragraph, lineOffset, lineLength, SBTrue);
+}
+
+/**
+ * Returns the number of code units preceding the trailing white space of a line, which gets reset
+ * to the paragraph level by rule L1.
+ */
+static SBUInteger FindTrailingStart(const SBBidiType *types, SBUInteger length)
+{
+    SBUInteger start = length;
+    SBUInteger index = length;
+
+    while (index--) {
+        switch (types[index]) {
+        case SBBidiTypeB:
+        case SBBidiTypeS:
+        case SBBidiTypeWS:
+        case SBBidiTypeLRI:
+        case SBBidiTypeRLI:
+        case SBBidiTypeFSI:
+        case SBBidiTypePDI:
+            start = index;
+            break;
+
+        case SBBidiTypeLRE:
+        case SBBidiTypeRLE:
+        case SBBidiTypeLRO:
+        case SBBidiTypeRLO:
+        case SBBidiTypePDF:
+        case SBBidiTypeBN:
+            /* These are reset only along with a preceding white space. */
+            break;
+
+        default:
+            return start;
+        }
+    }
+
+    return start;
+}
+
+/**
+ * Measures a candidate line from the runs resolved for the longest candidate, in which everything
+ * except the trailing white space is already reset in accordance with rule L1.
+ */
+static SBInteger MeasureTrialLine(const SBRun *runs, SBUInteger runCount,
+    const SBBidiType *types, SBUInteger lineOffset, SBUInteger lineLength, SBLevel baseLevel,
+    SBRunMeasureFunc measureRun, void *object)
+{
+    SBUInteger trailingStart = FindTrailingStart(types, lineLength);
+    SBUInteger trailingOffset = lineOffset + trailingStart;
+    SBInteger width = 0;
+    SBRun run;
+    SBUInteger runIndex;
+
+    run.offset = lineOffset;
+    run.length = 0;
+    run.level = SBLevelInvalid;
+
+    for (runIndex = 0; runIndex < runCount && runs[runIndex].offset < trailingOffset; runIndex++) {
+        SBUInteger runLimit = runs[runIndex].offset + runs[runIndex].length;
+
+        if (run.length > 0) {
+            width += measureRun(object, &run);
+        }
+
+        run.offset = runs[runIndex].offset;
+        run.length = SBNumberGetMin(runLimit, trailingOffset) - run.offset;
+        run.level = runs[runIndex].level;
+    }
+
+    if (trailingStart < lineLength) {
+        if (run.length > 0 && run.level == baseLevel) {
+            run.length += lineLength - trailingStart;
+        } else {
+            if (run.length > 0) {
+                width += measureRun(object, &run);
+            }
+
+            run.offset = trailingOffset;
+            run.length = lineLength - trailingStart;
+            run.level = baseLevel;
+        }
+    }
+
+    width += measureRun(object, &run);
+
+    return width;
+}
+
+SB_INTERNAL SBLineRef SBLineCreateFitting(SBParagraphRef paragraph,
+    SBUInteger lineOffset, const SBUInteger *lineLengths, SBUInteger candidateCount,
+    SBInteger maxWidth, SBRunMeasureFunc measureRun, void *object)
+{
+    SBUInteger innerOffset = lineOffset - paragraph->offset;
+    const SBBidiType *refTypes = paragraph->refTypes + innerOffset;
+    const SBLevel *refLevels = paragraph->fixedLevels + innerOffset;
+    SBUInteger longestLength = lineLengths[candidateCount - 1];
+    SBUInteger chosenIndex = 0;
+    SBBoolean isMeasured = SBFalse;
+    InlineLineContext storage;
+    LineContextRef context;
+    SBRun *runs;
+
+    context = CreateLineContext(refTypes, refLevels, longestLength, &storage);
+    if (!context) {
+        return NULL;
+    }
+
+    /* Resolve the levels once, leaving the trailing white space to each candidate. */
+    ResetLevels(context, paragraph->baseLevel, longestLength, SBFalse);
+
+    runs = malloc(sizeof(SBRun) * context->runCount);
+
+    if (runs) {
+        SBUInteger runCount = InitializeRuns(runs, context->fixedLevels, longestLength, lineOffset);
+        SBUInteger low = 0;
+        SBUInteger high = candidateCount;
+
+        /* Find the longest candidate that fits in the width. */
+        while (low < high) {
+            SBUInteger mid = low + (high - low) / 2;
+            SBInteger width = MeasureTrialLine(runs, runCount, refTypes, lineOffset, lineLengths[mid],
+                                               paragraph->baseLevel, measureRun, object);
+
+            if (width <= maxWidth) {
+                chosenIndex = mid;
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+
+        free(runs);
+        isMeasured = SBTrue;
+    }
+
+    DisposeLineContext(context);
+
+    if (!isMeasured) {
+        return NULL;
+    }
+
+    return SBLineCreate(paragraph, lineOffset, lineLengths[chosenIndex]);
+}
+
+SB_INTERNAL SBUInteger SBLineFindMirrorCandidate(SBLineRef line,
+    SBUInteger stringIndex, SBUInteger stringLimit)
+{
+    const SBUInt8 *mirrorUnits = line->fixedMirrorUnits;
+    SBUInteger unitIndex = stringIndex - line->offset;
+    SBUInteger unitLimit = stringLimit - line->offset;
+
+    while (unitIndex < unitLimit) {
+        SBUInt8 bits = (SBUInt8)(mirrorUnits[unitIndex >> 3] >> (unitIndex & 7));
+
+        if (bits) {
+            while (!(bits & 1)) {
+                bits >>= 1;
+                unitIndex += 1;
+            }
+
+            if (unitIndex < unitLimit) {
+                return line->offset + unitIndex;
+            }
+            break;
+        }
+
+        /* Skip the rest of the byte as it has no marked code unit. */
+        unitIndex = (unitIndex | 7) + 1;
+    }
+
+    return stringLimit;
+}
+
 SBUInteger SBLineGetOffset(SBLineRef line)
 {
     return line->offset;
@@ -303,9 +611,392 @@ const SBRun *SBLineGetRunsPtr(SBLineRef line)
     return line->fixedRuns;
 }
 
+static SBUInteger FindRun(const SBRun *runs, SBUInteger runCount, SBUInteger startIndex,
+    SBUInteger offset, SBUInteger length, SBLevel level)
+{
+    SBUInteger counter;
+
+    /* Begin with the run following the last match as unchanged runs mostly keep their order. */
+    for (counter = 0; counter < runCount; counter++) {
+        SBUInteger runIndex = startIndex + counter;
+        const SBRun *run;
+
+        if (runIndex >= runCount) {
+            runIndex -= runCount;
+        }
+
+        run = &runs[runIndex];
+
+        if (run->offset == offset && run->length == length && run->level == level) {
+            return runIndex;
+        }
+    }
+
+    return SBRunMatchNone;
+}
+
+SBUInteger SBLineMatchRuns(SBLineRef line, SBLineRef previousLine,
+    SBUInteger editOffset, SBUInteger oldLength, SBUInteger newLength, SBUInteger *runMatches)
+{
+    SBUInteger editLimit = editOffset + newLength;
+    SBUInteger searchIndex = 0;
+    SBUInteger changeCount = 0;
+    SBUInteger runIndex;
+
+    for (runIndex = 0; runIndex < line->runCount; runIndex++) {
+        const SBRun *run = &line->fixedRuns[runIndex];
+        SBUInteger matchIndex = SBRunMatchNone;
+
+        /* A run overlapping the edit has changed regardless of its boundaries. */
+        if (run->offset + run->length <= editOffset || run->offset >= editLimit) {
+            SBUInteger previousOffset = run->offset;
+
+            if (previousOffset >= editLimit) {
+                previousOffset = previousOffset - newLength + oldLength;
+            }
+
+            matchIndex = FindRun(previousLine->fixedRuns, previousLine->runCount, searchIndex,
+                                 previousOffset, run->length, run->level);
+        }
+
+        if (matchIndex != SBRunMatchNone) {
+            searchIndex = matchIndex + 1;
+        } else {
+            changeCount += 1;
+        }
+
+        if (runMatches) {
+            runMatches[runIndex] = matchIndex;
+        }
+    }
+
+    return changeCount;
+}
+
+static SBCodepoint GetVisualCodepoint(const SBCodepointSequence *sequence,
+    SBUInteger *stringIndex, SBBoolean isMirrored)
+{
+    SBCodepoint codepoint = SBCodepointSequenceGetCodepointAt(sequence, stringIndex);
+
+    if (isMirrored) {
+        SBCodepoint mirror = LookupMirror(codepoint);
+
+        if (mirror) {
+            codepoint = mirror;
+        }
+    }
+
+    return codepoint;
+}
+
+static SBUInteger MeasureVisualRun(const SBCodepointSequence *sequence,
+    const SBRun *run, SBBoolean isMirrored, SBStringEncoding encoding)
+{
+    SBUInteger stringIndex = run->offset;
+    SBUInteger runLimit = run->offset + run->length;
+    SBUInteger unitCount = 0;
+
+    while (stringIndex < runLimit) {
+        SBCodepoint codepoint = GetVisualCodepoint(sequence, &stringIndex, isMirrored);
+        unitCount += SBCodepointEncode(codepoint, encoding, NULL, 0);
+    }
+
+    return unitCount;
+}
+
+static void ReverseUnits(void *buffer, SBUInteger unitSize,
+    SBUInteger startIndex, SBUInteger endIndex)
+{
+    SBUInt8 *first = (SBUInt8 *)buffer + startIndex * unitSize;
+    SBUInt8 *last = (SBUInt8 *)buffer + endIndex * unitSize;
+
+    while ((SBUInteger)(last - first) > unitSize) {
+        SBUInteger byteIndex;
+
+        last -= unitSize;
+
+        for (byteIndex = 0; byteIndex < unitSize; byteIndex++) {
+            SBUInt8 byte = first[byteIndex];
+            first[byteIndex] = last[byteIndex];
+            last[byteIndex] = byte;
+        }
+
+        first += unitSize;
+    }
+}
+
+/**
+ * Reverses the code points encoded in a range of the buffer while keeping the units of each one in
+ * their original order.
+ */
+static void ReverseCodepoints(void *buffer, SBStringEncoding encoding,
+    SBUInteger startIndex, SBUInteger endIndex)
+{
+    switch (encoding) {
+    case SBStringEncodingUTF8: {
+        const SBUInt8 *units = (const SBUInt8 *)buffer;
+
+        ReverseUnits(buffer, sizeof(SBUInt8), startIndex, endIndex);
+
+        /* The trailing bytes of each code point now precede its lead byte. */
+        while (startIndex < endIndex) {
+            SBUInteger leadIndex = startIndex;
+
+            while ((units[leadIndex] & 0xC0) == 0x80) {
+                leadIndex += 1;
+            }
+
+            ReverseUnits(buffer, sizeof(SBUInt8), startIndex, leadIndex + 1);
+            startIndex = leadIndex + 1;
+        }
+        break;
+    }
+
+    case SBStringEncodingUTF16: {
+        const SBUInt16 *units = (const SBUInt16 *)buffer;
+
+        ReverseUnits(buffer, sizeof(SBUInt16), startIndex, endIndex);
+
+        /* The trail surrogate of each pair now precedes its lead surrogate. */
+        while (startIndex < endIndex) {
+            if (SBUInt16InRange(units[startIndex], 0xDC00, 0xDFFF)) {
+                ReverseUnits(buffer, sizeof(SBUInt16), startIndex, startIndex + 2);
+                startIndex += 2;
+            } else {
+                startIndex += 1;
+            }
+        }
+        break;
+    }
+
+    case SBStringEncodingUTF32:
+        ReverseUnits(buffer, sizeof(SBUInt32), startIndex, endIndex);
+        break;
+    }
+}
+
+static SBUInteger WriteVisualRun(const SBCodepointSequence *sequence, const SBRun *run,
+    SBBoolean isMirrored, SBStringEncoding encoding, void *buffer, SBUInteger outputIndex)
+{
+    SBUInteger stringIndex = run->offset;
+    SBUInteger runLimit = run->offset + run->length;
+    SBUInteger startIndex = outputIndex;
+
+    while (stringIndex < runLimit) {
+        SBCodepoint codepoint = GetVisualCodepoint(sequence, &stringIndex, isMirrored);
+        outputIndex += SBCodepointEncode(codepoint, encoding, buffer, outputIndex);
+    }
+
+    /*
+     * The code points of a right-to-left run are written in logical order first and then reversed
+     * in place, which keeps multi-unit code points intact without measuring the run beforehand.
+     */
+    if (run->level & 1) {
+        ReverseCodepoints(buffer, encoding, startIndex, outputIndex);
+    }
+
+    return outputIndex - startIndex;
+}
+
+SBUInteger SBLineCopyVisualString(SBLineRef line, SBStringEncoding encoding,
+    void *buffer, SBUInteger capacity)
+{
+    const SBCodepointSequence *sequence = &line->codepointSequence;
+    SBUInteger stringSize = 0;
+    SBUInteger runIndex;
+
+    if (encoding != SBStringEncodingUTF8
+        && encoding != SBStringEncodingUTF16
+        && encoding != SBStringEncodingUTF32) {
+        return 0;
+    }
+
+    for (runIndex = 0; runIndex < line->runCount; runIndex++) {
+        stringSize += MeasureVisualRun(sequence, &line->fixedRuns[runIndex],
+                                       line->fixedMirrorRuns[runIndex], encoding);
+    }
+
+    if (buffer && capacity >= stringSize) {
+        SBUInteger outputIndex = 0;
+
+        for (runIndex = 0; runIndex < line->runCount; runIndex++) {
+            outputIndex += WriteVisualRun(sequence, &line->fixedRuns[runIndex],
+                                          line->fixedMirrorRuns[runIndex], encoding,
+                                          buffer, outputIndex);
+        }
+    }
+
+    return stringSize;
+}
+
+SBUInteger SBLineGetVisualRangesForLogicalRange(SBLineRef line,
+    SBUInteger offset, SBUInteger length, SBVisualRange *ranges, SBUInteger capacity)
+{
+    SBUInteger logicalLimit;
+    SBUInteger innerOffset;
+    SBUInteger visualOffset = 0;
+    SBUInteger rangeCount = 0;
+    SBVisualRange range = { 0, 0 };
+    SBUInteger runIndex;
+
+    /* Drop the part of the range lying before the line. */
+    if (offset < line->offset) {
+        SBUInteger skippedLength = line->offset - offset;
+
+        if (length <= skippedLength) {
+            return 0;
+        }
+
+        offset = line->offset;
+        length -= skippedLength;
+    }
+
+    /* Clamp the rest to the line so that the limit cannot overflow. */
+    innerOffset = offset - line->offset;
+    SBUIntegerNormalizeRange(line->length, &innerOffset, &length);
+
+    if (length == 0) {
+        return 0;
+    }
+
+    logicalLimit = offset + length;
+
+    for (runIndex = 0; runIndex < line->runCount; runIndex++) {
+        const SBRun *run = &line->fixedRuns[runIndex];
+        SBUInteger runLimit = run->offset + run->length;
+        SBUInteger start = SBNumberGetMax(offset, run->offset);
+        SBUInteger end = SBNumberGetMin(logicalLimit, runLimit);
+
+        if (start < end) {
+            SBUInteger visualStart;
+
+            if (run->level & 1) {
+                visualStart = visualOffset + (runLimit - end);
+            } else {
+                visualStart = visualOffset + (start - run->offset);
+            }
+
+            if (rangeCount > 0 && range.offset + range.length == visualStart) {
+                /* The range continues the previous one on screen, so extend it. */
+                range.length += end - start;
+            } else {
+                if (rangeCount > 0 && rangeCount <= capacity) {
+                    ranges[rangeCount - 1] = range;
+                }
+
+                range.offset = visualStart;
+                range.length = end - start;
+                rangeCount += 1;
+            }
+        }
+
+        visualOffset += run->length;
+    }
+
+    if (rangeCount > 0 && rangeCount <= capacity) {
+        ranges[rangeCount - 1] = range;
+    }
+
+    return rangeCount;
+}
+
+/**
+ * Returns the index of the last attribute run starting at or before the given index.
+ */
+static SBUInteger FindAttribute(const SBUInteger *attributeOffsets, SBUInteger attributeCount,
+    SBUInteger stringIndex)
+{
+    SBUInteger low = 0;
+    SBUInteger high = attributeCount;
+
+    while (low < high) {
+        SBUInteger mid = low + (high - low) / 2;
+
+        if (attributeOffsets[mid] <= stringIndex) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return (low > 0 ? low - 1 : 0);
+}
+
+static SBUInteger AppendItem(SBLineItem *items, SBUInteger capacity, SBUInteger itemCount,
+    SBUInteger offset, SBUInteger length, SBUInteger attributeIndex, SBLevel level)
+{
+    if (length == 0) {
+        return itemCount;
+    }
+
+    if (itemCount < capacity) {
+        SBLineItem *item = &items[itemCount];
+
+        item->offset = offset;
+        item->length = length;
+        item->attributeIndex = attributeIndex;
+        item->level = level;
+    }
+
+    return itemCount + 1;
+}
+
+SBUInteger SBLineGetItems(SBLineRef line,
+    const SBUInteger *attributeOffsets, SBUInteger attributeCount,
+    SBLineItem *items, SBUInteger capacity)
+{
+    SBUInteger itemCount = 0;
+    SBUInteger runIndex;
+
+    for (runIndex = 0; runIndex < line->runCount; runIndex++) {
+        const SBRun *run = &line->fixedRuns[runIndex];
+        SBUInteger runLimit = run->offset + run->length;
+
+        if (run->level & 1) {
+            /* Walk the attribute runs backward so that the items come out in visual order. */
+            SBUInteger attributeIndex = FindAttribute(attributeOffsets, attributeCount, runLimit - 1);
+            SBUInteger end = runLimit;
+
+            while (end > run->offset) {
+                SBUInteger start = run->offset;
+
+                /* The first attribute run covers everything before it as well. */
+                if (attributeIndex > 0 && attributeOffsets[attributeIndex] > start) {
+                    start = attributeOffsets[attributeIndex];
+                }
+
+                itemCount = AppendItem(items, capacity, itemCount,
+                                       start, end - start, attributeIndex, run->level);
+
+                end = start;
+                attributeIndex -= 1;
+            }
+        } else {
+            SBUInteger attributeIndex = FindAttribute(attributeOffsets, attributeCount, run->offset);
+            SBUInteger start = run->offset;
+
+            while (start < runLimit) {
+                SBUInteger end = runLimit;
+
+                if (attributeIndex + 1 < attributeCount && attributeOffsets[attributeIndex + 1] < end) {
+                    end = attributeOffsets[attributeIndex + 1];
+                }
+
+                itemCount = AppendItem(items, capacity, itemCount,
+                                       start, end - start, attributeIndex, run->level);
+
+                start = end;
+                attributeIndex += 1;
+            }
+        }
+    }
+
+    return itemCount;
+}
+
 SBLineRef SBLineRetain(SBLineRef line)
 {
-    if (line) {
+    if (line && !line->arena) {
         line->retainCount += 1;
     }
     
@@ -314,7 +1005,8 @@ SBLineRef SBLineRetain(SBLineRef line)
 
 void SBLineRelease(SBLineRef line)
 {
-    if (line && --line->retainCount == 0) {
+    if (line && !line->arena && --line->retainCount == 0) {
+        SBAlgorithmRelease(line->retainedAlgorithm);
         free(line);
     }
 }
@@ -17,6 +17,8 @@
 #ifndef _SB_INTERNAL_LINE_H
 #define _SB_INTERNAL_LINE_H
 
+#include <SBAlgorithm.h>
+#include <SBArena.h>
 #include <SBBase.h>
 #include <SBCodepointSequence.h>
 #include <SBConfig.h>
@@ -27,13 +29,29 @@
 typedef struct _SBLine {
     SBCodepointSequence codepointSequence;
     SBRun *fixedRuns;
+    SBBoolean *fixedMirrorRuns;
+    SBUInt8 *fixedMirrorUnits;
+    SBAlgorithmRef retainedAlgorithm;
     SBUInteger runCount;
     SBUInteger offset;
     SBUInteger length;
+    SBArenaRef arena;
     SBUInteger retainCount;
 } SBLine;
 
 SB_INTERNAL SBLineRef SBLineCreate(SBParagraphRef paragraph,
     SBUInteger lineOffset, SBUInteger lineLength);
+SB_INTERNAL SBLineRef SBLineCreateRetainingString(SBParagraphRef paragraph,
+    SBUInteger lineOffset, SBUInteger lineLength);
+
+SB_INTERNAL SBLineRef SBLineCreateFitting(SBParagraphRef paragraph,
+    SBUInteger lineOffset, const SBUInteger *lineLengths, SBUInteger candidateCount,
+    SBInteger maxWidth, SBRunMeasureFunc measureRun, void *object);
+SB_INTERNAL SBUInteger SBLineResetLevels(const SBBidiType *types, const SBLevel *levels,
+    SBUInteger length, SBLevel baseLevel, SBLevel *lineLevels);
+SB_INTERNAL SBUInteger SBLineFillRuns(const SBLevel *lineLevels, SBUInteger length,
+    SBUInteger lineOffset, SBRun *runs);
+SB_INTERNAL SBUInteger SBLineFindMirrorCandidate(SBLineRef line,
+    SBUInteger stringIndex, SBUInteger stringLimit);
 
 #endif
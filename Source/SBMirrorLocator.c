@@ -39,6 +39,7 @@ SBMirrorLocatorRef SBMirrorLocatorCreate(void)
 void SBMirrorLocatorLoadLine(SBMirrorLocatorRef locator, SBLineRef line, void *stringBuffer)
 {
     SBLineRelease(locator->_line);
+    locator->_line = NULL;
 
     if (line && stringBuffer == line->codepointSequence.stringBuffer) {
         locator->_line = SBLineRetain(line);
@@ -52,17 +53,42 @@ const SBMirrorAgent *SBMirrorLocatorGetAgent(SBMirrorLocatorRef locator)
     return &locator->agent;
 }
 
+static SBBoolean FindNextMirror(SBLineRef line,
+    SBUInteger *stringIndex, SBUInteger stringLimit, SBMirrorAgent *agent)
+{
+    const SBCodepointSequence *sequence = &line->codepointSequence;
+    SBUInteger index = *stringIndex;
+
+    while ((index = SBLineFindMirrorCandidate(line, index, stringLimit)) < stringLimit) {
+        SBUInteger initialIndex = index;
+        SBCodepoint codepoint = SBCodepointSequenceGetCodepointAt(sequence, &index);
+        SBCodepoint mirror = LookupMirror(codepoint);
+
+        if (mirror) {
+            *stringIndex = index;
+            agent->index = initialIndex;
+            agent->mirror = mirror;
+            agent->codepoint = codepoint;
+
+            return SBTrue;
+        }
+    }
+
+    *stringIndex = stringLimit;
+
+    return SBFalse;
+}
+
 SBBoolean SBMirrorLocatorMoveNext(SBMirrorLocatorRef locator)
 {
     SBLineRef line = locator->_line;
 
     if (line) {
-        const SBCodepointSequence *sequence = &line->codepointSequence;
-
         do {
             const SBRun *run = &line->fixedRuns[locator->_runIndex];
 
-            if (run->level & 1) {
+            /* Skip the runs having no code point that could be mirrored. */
+            if (line->fixedMirrorRuns[locator->_runIndex]) {
                 SBUInteger stringIndex;
                 SBUInteger stringLimit;
 
@@ -72,19 +98,9 @@ SBBoolean SBMirrorLocatorMoveNext(SBMirrorLocatorRef locator)
                 }
                 stringLimit = run->offset + run->length;
 
-                while (stringIndex < stringLimit) {
-                    SBUInteger initialIndex = stringIndex;
-                    SBCodepoint codepoint = SBCodepointSequenceGetCodepointAt(sequence, &stringIndex);
-                    SBCodepoint mirror = LookupMirror(codepoint);
-
-                    if (mirror) {
-                        locator->_stringIndex = stringIndex;
-                        locator->agent.index = initialIndex;
-                        locator->agent.mirror = mirror;
-                        locator->agent.codepoint = codepoint;
-
-                        return SBTrue;
-                    }
+                if (FindNextMirror(line, &stringIndex, stringLimit, &locator->agent)) {
+                    locator->_stringIndex = stringIndex;
+                    return SBTrue;
                 }
             }
             
@@ -121,3 +137,55 @@ void SBMirrorLocatorRelease(SBMirrorLocatorRef locator)
         free(locator);
     }
 }
+
+SBUInteger SBLineGetMirrors(SBLineRef line, SBMirrorAgent *agents, SBUInteger capacity)
+{
+    SBUInteger mirrorCount = 0;
+    SBUInteger runIndex;
+
+    for (runIndex = 0; runIndex < line->runCount; runIndex++) {
+        if (line->fixedMirrorRuns[runIndex]) {
+            const SBRun *run = &line->fixedRuns[runIndex];
+            SBUInteger stringIndex = run->offset;
+            SBUInteger stringLimit = run->offset + run->length;
+            SBMirrorAgent agent;
+
+            while (FindNextMirror(line, &stringIndex, stringLimit, &agent)) {
+                if (mirrorCount < capacity) {
+                    agents[mirrorCount] = agent;
+                }
+                mirrorCount += 1;
+            }
+        }
+    }
+
+    return mirrorCount;
+}
+
+SBUInteger SBLineApplyMirroring(SBLineRef line, SBCodepoint *codepoints, const SBUInteger *indexMap)
+{
+    SBUInteger mirrorCount = 0;
+    SBUInteger runIndex;
+
+    for (runIndex = 0; runIndex < line->runCount; runIndex++) {
+        if (line->fixedMirrorRuns[runIndex]) {
+            const SBRun *run = &line->fixedRuns[runIndex];
+            SBUInteger stringIndex = run->offset;
+            SBUInteger stringLimit = run->offset + run->length;
+            SBMirrorAgent agent;
+
+            while (FindNextMirror(line, &stringIndex, stringLimit, &agent)) {
+                SBUInteger bufferIndex = agent.index - line->offset;
+
+                if (indexMap) {
+                    bufferIndex = indexMap[bufferIndex];
+                }
+
+                codepoints[bufferIndex] = agent.mirror;
+                mirrorCount += 1;
+            }
+        }
+    }
+
+    return mirrorCount;
+}
@@ -24,49 +24,131 @@
 #include "LevelRun.h"
 #include "RunQueue.h"
 #include "SBAlgorithm.h"
+#include "SBArena.h"
 #include "SBAssert.h"
 #include "SBBase.h"
 #include "SBCodepointSequence.h"
+#include "SBExecutor.h"
 #include "SBLine.h"
 #include "SBLog.h"
 #include "StatusStack.h"
 #include "SBParagraph.h"
 
+#define UnlimitedBudget     SBInvalidIndex
+
+enum {
+    ParagraphStageExplicit  = 0,    /**< Determining explicit levels of the links. */
+    ParagraphStageIsolating = 1,    /**< Resolving the queued isolating runs. */
+    ParagraphStageSaving    = 2,    /**< Saving the resolved levels. */
+    ParagraphStageCompleted = 3,
+    ParagraphStageFailed    = 4,
+    ParagraphStageExceeded  = 5     /**< A resource limit has been hit. */
+};
+typedef SBUInt8 ParagraphStage;
+
 typedef struct _ParagraphContext {
     BidiChain bidiChain;
     StatusStack statusStack;
     RunQueue runQueue;
     IsolatingRun isolatingRun;
-} ParagraphContext, *ParagraphContextRef;
+    SBParagraphRef paragraph;
+    SBLevel *savedLevels;
+    BidiLink savedLink;
+    SBUInteger savedLength;
+    SBLevel savedLevel;
+    BidiLink priorLink;
+    BidiLink firstLink;
+    SBUInteger overIsolate;
+    SBUInteger overEmbedding;
+    SBUInteger validIsolate;
+    SBUInteger runSpan;
+    SBUInteger budget;
+    SBUInteger fixedBytes;
+    SBUInteger operationCount;
+    SBResourceLimits limits;
+    SBLevel baseLevel;
+    SBLevel priorLevel;
+    SBBidiType sor;
+    SBBoolean isRunResolving;
+    SBBoolean isAllocated;
+    ParagraphStage stage;
+} ParagraphContext;
+
+typedef struct _InlineParagraphContext {
+    ParagraphContext context;
+    BidiLink links[SBInlineCapacity + 2];
+    SBBidiType types[SBInlineCapacity + 2];
+    SBLevel levels[SBInlineCapacity + 2];
+} InlineParagraphContext;
+
+typedef struct _LineBatch {
+    SBParagraphRef paragraph;
+    const SBUInteger *lineLengths;
+    SBLineRef *lines;
+    SBUInteger lineOffset;
+    SBUInteger lineCount;
+    SBBoolean isSucceeded;
+} LineBatch, *LineBatchRef;
 
 static void PopulateBidiChain(BidiChainRef chain, const SBBidiType *types, SBUInteger length);
-static SBBoolean ProcessRun(ParagraphContextRef context, const LevelRunRef levelRun, SBBoolean forceFinish);
 
-static ParagraphContextRef CreateParagraphContext(const SBBidiType *types, SBLevel *levels, SBUInteger length)
+static SBUInteger MeasureFixedMemory(SBUInteger length)
+{
+    const SBUInteger sizeParagraph = sizeof(SBParagraph) + sizeof(SBLevel) * (length + 2);
+    const SBUInteger sizeContext   = sizeof(ParagraphContext) + (sizeof(BidiLink) + sizeof(SBBidiType)) * (length + 2);
+
+    return sizeParagraph + sizeContext;
+}
+
+static SBUInteger MeasureParagraphContext(SBUInteger capacity, SBBoolean hasLevels)
 {
     const SBUInteger sizeContext = sizeof(ParagraphContext);
-    const SBUInteger sizeLinks   = sizeof(BidiLink) * (length + 2);
-    const SBUInteger sizeTypes   = sizeof(SBBidiType) * (length + 2);
-    const SBUInteger sizeMemory  = sizeContext + sizeLinks + sizeTypes;
+    const SBUInteger sizeLinks   = sizeof(BidiLink) * (capacity + 2);
+    const SBUInteger sizeTypes   = sizeof(SBBidiType) * (capacity + 2);
+    const SBUInteger sizeLevels  = (hasLevels ? 0 : sizeof(SBLevel) * (capacity + 2));
 
-    void *pointer = malloc(sizeMemory);
+    return sizeContext + sizeLinks + sizeTypes + sizeLevels;
+}
 
-    if (pointer) {
-        const SBUInteger offsetContext = 0;
-        const SBUInteger offsetLinks   = offsetContext + sizeContext;
-        const SBUInteger offsetTypes   = offsetLinks + sizeLinks;
+static ParagraphContextRef PlaceParagraphContext(void *pointer, SBUInteger capacity, SBLevel *levels)
+{
+    const SBUInteger sizeContext = sizeof(ParagraphContext);
+    const SBUInteger sizeLinks   = sizeof(BidiLink) * (capacity + 2);
+    const SBUInteger sizeTypes   = sizeof(SBBidiType) * (capacity + 2);
+
+    const SBUInteger offsetContext = 0;
+    const SBUInteger offsetLinks   = offsetContext + sizeContext;
+    const SBUInteger offsetTypes   = offsetLinks + sizeLinks;
+    const SBUInteger offsetLevels  = offsetTypes + sizeTypes;
+
+    SBUInt8 *memory = (SBUInt8 *)pointer;
+    ParagraphContextRef context = (ParagraphContextRef)(memory + offsetContext);
+    BidiLink *fixedLinks = (BidiLink *)(memory + offsetLinks);
+    SBBidiType *fixedTypes = (SBBidiType *)(memory + offsetTypes);
+
+    /* Keep the levels of the chain in the context if the caller has not provided them. */
+    if (!levels) {
+        levels = (SBLevel *)(memory + offsetLevels);
+    }
 
-        SBUInt8 *memory = (SBUInt8 *)pointer;
-        ParagraphContextRef context = (ParagraphContextRef)(memory + offsetContext);
-        BidiLink *fixedLinks = (BidiLink *)(memory + offsetLinks);
-        SBBidiType *fixedTypes = (SBBidiType *)(memory + offsetTypes);
+    BidiChainInitialize(&context->bidiChain, fixedTypes, levels, fixedLinks);
+    StatusStackInitialize(&context->statusStack);
+    RunQueueInitialize(&context->runQueue);
+    IsolatingRunInitialize(&context->isolatingRun);
 
-        BidiChainInitialize(&context->bidiChain, fixedTypes, levels, fixedLinks);
-        StatusStackInitialize(&context->statusStack);
-        RunQueueInitialize(&context->runQueue);
-        IsolatingRunInitialize(&context->isolatingRun);
+    context->paragraph = NULL;
+    context->isAllocated = SBFalse;
 
-        PopulateBidiChain(&context->bidiChain, types, length);
+    return context;
+}
+
+static ParagraphContextRef AllocateParagraphContext(SBUInteger capacity, SBLevel *levels)
+{
+    void *pointer = malloc(MeasureParagraphContext(capacity, levels != NULL));
+
+    if (pointer) {
+        ParagraphContextRef context = PlaceParagraphContext(pointer, capacity, levels);
+        context->isAllocated = SBTrue;
 
         return context;
     }
@@ -74,21 +156,63 @@ static ParagraphContextRef CreateParagraphContext(const SBBidiType *types, SBLev
     return NULL;
 }
 
-static void DisposeParagraphContext(ParagraphContextRef context)
+static ParagraphContextRef ObtainParagraphContext(SBUInteger capacity, SBLevel *levels,
+    InlineParagraphContext *storage)
+{
+    /* Keep the context of a short paragraph in the given storage rather than allocating it. */
+    if (storage && capacity <= SBInlineCapacity) {
+        return PlaceParagraphContext(storage, capacity, levels);
+    }
+
+    return AllocateParagraphContext(capacity, levels);
+}
+
+static ParagraphContextRef CreateParagraphContext(const SBBidiType *types, SBLevel *levels,
+    SBUInteger length, InlineParagraphContext *storage)
+{
+    ParagraphContextRef context = ObtainParagraphContext(length, levels, storage);
+
+    if (context) {
+        PopulateBidiChain(&context->bidiChain, types, length);
+    }
+
+    return context;
+}
+
+static void ResetParagraphContext(ParagraphContextRef context, const SBBidiType *types, SBUInteger length)
+{
+    BidiChainRef chain = &context->bidiChain;
+
+    BidiChainInitialize(chain, chain->types, chain->levels, chain->links);
+    StatusStackSetEmpty(&context->statusStack);
+    RunQueueReset(&context->runQueue);
+
+    PopulateBidiChain(chain, types, length);
+}
+
+static void FinalizeParagraphContext(ParagraphContextRef context)
 {
     StatusStackFinalize(&context->statusStack);
     RunQueueFinalize(&context->runQueue);
     IsolatingRunFinalize(&context->isolatingRun);
-    free(context);
 }
 
-static SBParagraphRef AllocateParagraph(SBUInteger length)
+static void DisposeParagraphContext(ParagraphContextRef context)
+{
+    FinalizeParagraphContext(context);
+
+    if (context->isAllocated) {
+        free(context);
+    }
+}
+
+static SBParagraphRef AllocateParagraph(SBArenaRef arena, SBUInteger length)
 {
     const SBUInteger sizeParagraph = sizeof(SBParagraph);
     const SBUInteger sizeLevels    = sizeof(SBLevel) * (length + 2);
     const SBUInteger sizeMemory    = sizeParagraph + sizeLevels;
 
-    void *pointer = malloc(sizeMemory);
+    void *pointer = (arena ? SBArenaAllocate(arena, sizeMemory) : malloc(sizeMemory));
 
     if (pointer) {
         const SBUInteger offsetParagraph = 0;
@@ -99,6 +223,7 @@ static SBParagraphRef AllocateParagraph(SBUInteger length)
         SBLevel *levels = (SBLevel *)(memory + offsetLevels);
 
         paragraph->fixedLevels = levels;
+        paragraph->arena = arena;
 
         return paragraph;
     }
@@ -108,7 +233,9 @@ static SBParagraphRef AllocateParagraph(SBUInteger length)
 
 static void DisposeParagraph(SBParagraphRef paragraph)
 {
-    free(paragraph);
+    if (paragraph && !paragraph->arena) {
+        free(paragraph);
+    }
 }
 
 static SBUInteger DetermineBoundary(SBAlgorithmRef algorithm, SBUInteger paragraphOffset, SBUInteger suggestedLength)
@@ -251,7 +378,55 @@ static SBLevel DetermineParagraphLevel(BidiChainRef chain, SBLevel baseLevel)
     return baseLevel;
 }
 
-static SBBoolean DetermineLevels(ParagraphContextRef context, SBLevel baseLevel)
+static SBBoolean IsMemoryExceeded(ParagraphContextRef context)
+{
+    SBUInteger maxBytes = context->limits.maxAllocatedBytes;
+
+    if (maxBytes != 0) {
+        SBUInteger totalBytes = context->fixedBytes
+                              + context->statusStack.allocatedBytes
+                              + context->runQueue.allocatedBytes
+                              + context->isolatingRun._bracketQueue.allocatedBytes;
+
+        return (totalBytes > maxBytes);
+    }
+
+    return SBFalse;
+}
+
+static SBBoolean ConsumeOperations(ParagraphContextRef context, SBUInteger count)
+{
+    SBUInteger maxOperations = context->limits.maxOperations;
+
+    if (maxOperations != 0) {
+        if (count > maxOperations - context->operationCount) {
+            return SBFalse;
+        }
+
+        context->operationCount += count;
+    }
+
+    return SBTrue;
+}
+
+static void InitializeLevels(ParagraphContextRef context, SBLevel baseLevel)
+{
+    context->priorLink = context->bidiChain.roller;
+    context->firstLink = BidiLinkNone;
+
+    context->baseLevel = baseLevel;
+    context->priorLevel = baseLevel;
+    context->sor = SBBidiTypeNil;
+
+    /* Rule X1 */
+    context->overIsolate = 0;
+    context->overEmbedding = 0;
+    context->validIsolate = 0;
+
+    StatusStackPush(&context->statusStack, baseLevel, SBBidiTypeON, SBFalse);
+}
+
+static SBBoolean DetermineLevels(ParagraphContextRef context)
 {
     BidiChainRef chain = &context->bidiChain;
     StatusStackRef stack = &context->statusStack;
@@ -262,6 +437,7 @@ static SBBoolean DetermineLevels(ParagraphContextRef context, SBLevel baseLevel)
     BidiLink firstLink;
     BidiLink lastLink;
 
+    SBLevel baseLevel;
     SBLevel priorLevel;
     SBBidiType sor;
     SBBidiType eor;
@@ -269,26 +445,43 @@ static SBBoolean DetermineLevels(ParagraphContextRef context, SBLevel baseLevel)
     SBUInteger overIsolate;
     SBUInteger overEmbedding;
     SBUInteger validIsolate;
+    SBUInteger budget;
 
-    priorLink = chain->roller;
-    firstLink = BidiLinkNone;
+    /* Restore the state saved at the time of suspension. */
+    priorLink = context->priorLink;
+    firstLink = context->firstLink;
     lastLink = BidiLinkNone;
 
-    priorLevel = baseLevel;
-    sor = SBBidiTypeNil;
-
-    /* Rule X1 */
-    overIsolate = 0;
-    overEmbedding = 0;
-    validIsolate = 0;
-
-    StatusStackPush(stack, baseLevel, SBBidiTypeON, SBFalse);
-
-    BidiChainForEach(chain, roller, link) {
+    baseLevel = context->baseLevel;
+    priorLevel = context->priorLevel;
+    sor = context->sor;
+
+    overIsolate = context->overIsolate;
+    overEmbedding = context->overEmbedding;
+    validIsolate = context->validIsolate;
+    budget = context->budget;
+
+    /*
+     * NOTE:
+     *      The next link is always taken from the prior one because the current link is either
+     *      merged in it or abandoned by it, in case the iteration is continued early.
+     */
+    while ((link = BidiChainGetNext(chain, priorLink)) != roller) {
         SBBoolean forceFinish = SBFalse;
         SBBoolean bnEquivalent = SBFalse;
         SBBidiType type;
 
+        if (budget == 0) {
+            goto Suspend;
+        }
+        if (budget != UnlimitedBudget) {
+            budget -= 1;
+        }
+        if (!ConsumeOperations(context, 1)) {
+            context->stage = ParagraphStageExceeded;
+            goto Suspend;
+        }
+
         type = BidiChainGetType(chain, link);
 
 #define LeastGreaterOddLevel()                                              \
@@ -498,9 +691,14 @@ static SBBoolean DetermineLevels(ParagraphContextRef context, SBLevel baseLevel)
 
             LevelRunInitialize(&levelRun, chain, firstLink, lastLink, sor, eor);
 
-            if (!ProcessRun(context, &levelRun, forceFinish)) {
+            if (!RunQueueEnqueue(&context->runQueue, &levelRun)) {
                 return SBFalse;
             }
+            if (IsMemoryExceeded(context)) {
+                priorLink = link;
+                context->stage = ParagraphStageExceeded;
+                goto Suspend;
+            }
 
             /* The sor of next run (if any) should be technically equal to eor of this run. */
             sor = eor;
@@ -508,117 +706,243 @@ static SBBoolean DetermineLevels(ParagraphContextRef context, SBLevel baseLevel)
             firstLink = link;
 
             priorLevel = currentLevel;
+
+            if (context->runQueue.shouldDequeue || forceFinish) {
+                /* Suspend the iteration so that the complete isolating runs get resolved. */
+                priorLink = link;
+                context->stage = ParagraphStageIsolating;
+                goto Suspend;
+            }
         }
 
         priorLink = link;
     }
 
+    context->stage = ParagraphStageSaving;
+
+Suspend:
+    context->priorLink = priorLink;
+    context->firstLink = firstLink;
+    context->priorLevel = priorLevel;
+    context->sor = sor;
+    context->overIsolate = overIsolate;
+    context->overEmbedding = overEmbedding;
+    context->validIsolate = validIsolate;
+    context->budget = budget;
+
     return SBTrue;
 }
 
-static SBBoolean ProcessRun(ParagraphContextRef context, const LevelRunRef levelRun, SBBoolean forceFinish)
+static SBUInteger MeasureIsolatingRun(LevelRunRef baseLevelRun)
 {
-    RunQueueRef queue = &context->runQueue;
+    SBUInteger span = 0;
+    LevelRunRef levelRun;
 
-    if (!RunQueueEnqueue(queue, levelRun)) {
-        return SBFalse;
+    for (levelRun = baseLevelRun; levelRun; levelRun = levelRun->next) {
+        span += levelRun->subsequentLink - levelRun->firstLink;
     }
 
-    if (queue->shouldDequeue || forceFinish) {
-        IsolatingRunRef isolatingRun = &context->isolatingRun;
-        LevelRunRef peek;
+    return span;
+}
+
+static SBBoolean ResolveIsolatingRuns(ParagraphContextRef context)
+{
+    RunQueueRef queue = &context->runQueue;
+    IsolatingRunRef isolatingRun = &context->isolatingRun;
+
+    /* Rule X10 */
+    while (queue->count != 0) {
+        SBBoolean isResolved;
+
+        if (context->budget == 0) {
+            return SBTrue;
+        }
+
+        if (!context->isRunResolving) {
+            LevelRunRef peek = queue->peek;
 
-        /* Rule X10 */
-        for (; queue->count != 0; RunQueueDequeue(queue)) {
-            peek = queue->peek;
             if (RunKindIsAttachedTerminating(peek->kind)) {
+                RunQueueDequeue(queue);
                 continue;
             }
 
             isolatingRun->baseLevelRun = peek;
 
-            if (!IsolatingRunResolve(isolatingRun)) {
-                return SBFalse;
+            context->runSpan = MeasureIsolatingRun(peek);
+            context->isRunResolving = SBTrue;
+        }
+
+        /* Each pass of the isolating run visits all of its links. */
+        if (!ConsumeOperations(context, context->runSpan)) {
+            context->stage = ParagraphStageExceeded;
+            return SBTrue;
+        }
+        if (context->budget != UnlimitedBudget) {
+            if (context->budget > context->runSpan) {
+                context->budget -= context->runSpan;
+            } else {
+                context->budget = 0;
             }
         }
+
+        if (!IsolatingRunResolvePass(isolatingRun, &isResolved)) {
+            return SBFalse;
+        }
+        if (IsMemoryExceeded(context)) {
+            context->stage = ParagraphStageExceeded;
+            return SBTrue;
+        }
+
+        if (isResolved) {
+            context->isRunResolving = SBFalse;
+            RunQueueDequeue(queue);
+        }
     }
 
+    context->stage = ParagraphStageExplicit;
+
     return SBTrue;
 }
 
-static void SaveLevels(BidiChainRef chain, SBLevel *levels, SBLevel baseLevel)
+static void SaveLevels(ParagraphContextRef context, BidiLink limitLink)
 {
+    BidiChainRef chain = &context->bidiChain;
+    SBLevel *levels = context->savedLevels;
     BidiLink roller = chain->roller;
+    BidiLink priorLink = context->savedLink;
     BidiLink link;
 
-    SBUInteger index = 0;
-    SBLevel level = baseLevel;
+    SBUInteger index = context->savedLength;
+    SBLevel level = context->savedLevel;
 
-    BidiChainForEach(chain, roller, link) {
+    /* The levels are not needed if the paragraph is being saved as runs. */
+    if (!levels) {
+        return;
+    }
+
+    /*
+     * NOTE:
+     *      The levels are written in place, but only behind the limit link, whose level as well as
+     *      the levels of the links following it may still change.
+     */
+    while ((link = BidiChainGetNext(chain, priorLink)) != roller) {
         SBUInteger offset = BidiChainGetOffset(chain, link);
 
         for (; index < offset; index++) {
             levels[index] = level;
         }
 
+        if (link == limitLink) {
+            break;
+        }
+
         level = BidiChainGetLevel(chain, link);
+        priorLink = link;
     }
+
+    context->savedLink = priorLink;
+    context->savedLength = index;
+    context->savedLevel = level;
 }
 
-static SBBoolean ResolveParagraph(SBParagraphRef paragraph,
-    SBAlgorithmRef algorithm, SBUInteger offset, SBUInteger length, SBLevel baseLevel)
+static SBLevel StartResolution(ParagraphContextRef context, SBAlgorithmRef algorithm,
+    SBUInteger paragraphOffset, SBUInteger paragraphLength, SBLevel baseLevel,
+    const SBResourceLimits *limits, SBLevel *levels)
 {
-    const SBBidiType *bidiTypes = algorithm->fixedTypes + offset;
-    SBBoolean isSucceeded = SBFalse;
-    ParagraphContextRef context;
-    SBLevel resolvedLevel;
+    SBLevel resolvedLevel = DetermineParagraphLevel(&context->bidiChain, baseLevel);
 
-    context = CreateParagraphContext(bidiTypes, paragraph->fixedLevels, length);
+    SB_LOG_BLOCK_OPENER("Determined Paragraph Level");
+    SB_LOG_STATEMENT("Base Level", 1, SB_LOG_LEVEL(resolvedLevel));
+    SB_LOG_BLOCK_CLOSER();
 
-    if (context) {
-        resolvedLevel = DetermineParagraphLevel(&context->bidiChain, baseLevel);
+    context->isolatingRun.codepointSequence = &algorithm->codepointSequence;
+    context->isolatingRun.bidiTypes = algorithm->fixedTypes + paragraphOffset;
+    context->isolatingRun.bidiChain = &context->bidiChain;
+    context->isolatingRun.paragraphOffset = paragraphOffset;
+    context->isolatingRun.paragraphLevel = resolvedLevel;
+
+    context->savedLevels = levels;
+    context->savedLink = context->bidiChain.roller;
+    context->savedLength = 0;
+    context->savedLevel = resolvedLevel;
+    context->runSpan = 0;
+    context->budget = 0;
+    context->fixedBytes = MeasureFixedMemory(paragraphLength);
+    context->operationCount = 0;
+    context->isRunResolving = SBFalse;
+    context->stage = ParagraphStageExplicit;
+
+    if (limits) {
+        context->limits = *limits;
+    } else {
+        context->limits.maxParagraphLength = 0;
+        context->limits.maxAllocatedBytes = 0;
+        context->limits.maxOperations = 0;
+    }
 
-        SB_LOG_BLOCK_OPENER("Determined Paragraph Level");
-        SB_LOG_STATEMENT("Base Level", 1, SB_LOG_LEVEL(resolvedLevel));
-        SB_LOG_BLOCK_CLOSER();
+    InitializeLevels(context, resolvedLevel);
 
-        context->isolatingRun.codepointSequence = &algorithm->codepointSequence;
-        context->isolatingRun.bidiTypes = bidiTypes;
-        context->isolatingRun.bidiChain = &context->bidiChain;
-        context->isolatingRun.paragraphOffset = offset;
-        context->isolatingRun.paragraphLevel = resolvedLevel;
+    return resolvedLevel;
+}
 
-        if (DetermineLevels(context, resolvedLevel)) {
-            SaveLevels(&context->bidiChain, ++paragraph->fixedLevels, resolvedLevel);
+static SBUInteger SaveRuns(BidiChainRef chain, SBLevel baseLevel,
+    SBUInteger paragraphOffset, SBRun *runs)
+{
+    BidiLink roller = chain->roller;
+    BidiLink link;
 
-            SB_LOG_BLOCK_OPENER("Determined Embedding Levels");
-            SB_LOG_STATEMENT("Levels", 1, SB_LOG_LEVELS_ARRAY(paragraph->fixedLevels, length));
-            SB_LOG_BLOCK_CLOSER();
+    SBUInteger runCount = 0;
+    SBUInteger index = 0;
+    SBLevel level = baseLevel;
+    SBRun lastRun;
 
-            paragraph->algorithm = SBAlgorithmRetain(algorithm);
-            paragraph->refTypes = bidiTypes;
-            paragraph->offset = offset;
-            paragraph->length = length;
-            paragraph->baseLevel = resolvedLevel;
-            paragraph->retainCount = 1;
+    lastRun.offset = 0;
+    lastRun.length = 0;
+    lastRun.level = SBLevelInvalid;
+
+    /* Cover the same spans as SaveLevels, merging the adjacent ones having equal levels. */
+    BidiChainForEach(chain, roller, link) {
+        SBUInteger offset = BidiChainGetOffset(chain, link);
 
-            isSucceeded = SBTrue;
+        if (offset > index) {
+            if (lastRun.level == level) {
+                lastRun.length += offset - index;
+            } else {
+                if (runs && runCount != 0) {
+                    runs[runCount - 1] = lastRun;
+                }
+
+                lastRun.offset = paragraphOffset + index;
+                lastRun.length = offset - index;
+                lastRun.level = level;
+
+                runCount += 1;
+            }
+
+            index = offset;
         }
 
-        DisposeParagraphContext(context);
+        level = BidiChainGetLevel(chain, link);
     }
 
-    return isSucceeded;
+    if (runs && runCount != 0) {
+        runs[runCount - 1] = lastRun;
+    }
+
+    return runCount;
 }
 
-SB_INTERNAL SBParagraphRef SBParagraphCreate(SBAlgorithmRef algorithm,
-    SBUInteger paragraphOffset, SBUInteger suggestedLength, SBLevel baseLevel)
+static ParagraphContextRef PrepareParagraphContext(SBAlgorithmRef algorithm,
+    SBUInteger paragraphOffset, SBUInteger suggestedLength, SBLevel baseLevel,
+    const SBResourceLimits *limits, SBResolverStatus *status, InlineParagraphContext *storage)
 {
     const SBCodepointSequence *codepointSequence = &algorithm->codepointSequence;
     SBUInteger stringLength = codepointSequence->stringLength;
+    const SBBidiType *bidiTypes = algorithm->fixedTypes + paragraphOffset;
     SBUInteger actualLength;
 
     SBParagraphRef paragraph;
+    ParagraphContextRef context;
 
     /* The given range MUST be valid. */
     SBAssert(SBUIntegerVerifyRange(stringLength, paragraphOffset, suggestedLength) && suggestedLength > 0);
@@ -635,11 +959,36 @@ SB_INTERNAL SBParagraphRef SBParagraphCreate(SBAlgorithmRef algorithm,
     SB_LOG_STATEMENT("Actual Length", 1, SB_LOG_NUMBER(actualLength));
     SB_LOG_BLOCK_CLOSER();
 
-    paragraph = AllocateParagraph(actualLength);
+    /* Refuse the paragraph before allocating anything if it goes beyond the limits. */
+    if (limits) {
+        if ((limits->maxParagraphLength != 0 && actualLength > limits->maxParagraphLength)
+            || (limits->maxAllocatedBytes != 0 && MeasureFixedMemory(actualLength) > limits->maxAllocatedBytes)) {
+            SB_LOG_BREAKER();
+
+            *status = SBResolverStatusLimitExceeded;
+            return NULL;
+        }
+    }
+
+    *status = SBResolverStatusFailed;
+    paragraph = AllocateParagraph(algorithm->arena, actualLength);
 
     if (paragraph) {
-        if (ResolveParagraph(paragraph, algorithm, paragraphOffset, actualLength, baseLevel)) {
-            return paragraph;
+        context = CreateParagraphContext(bidiTypes, paragraph->fixedLevels, actualLength, storage);
+
+        if (context) {
+            context->paragraph = paragraph;
+
+            paragraph->baseLevel = StartResolution(context, algorithm, paragraphOffset, actualLength,
+                                                   baseLevel, limits, paragraph->fixedLevels + 1);
+            paragraph->algorithm = SBAlgorithmRetain(algorithm);
+            paragraph->refTypes = bidiTypes;
+            paragraph->offset = paragraphOffset;
+            paragraph->length = actualLength;
+            paragraph->retainCount = 1;
+
+            *status = SBResolverStatusInProgress;
+            return context;
         }
 
         DisposeParagraph(paragraph);
@@ -650,6 +999,243 @@ SB_INTERNAL SBParagraphRef SBParagraphCreate(SBAlgorithmRef algorithm,
     return NULL;
 }
 
+SB_INTERNAL ParagraphContextRef SBParagraphCreateContext(SBAlgorithmRef algorithm,
+    SBUInteger paragraphOffset, SBUInteger suggestedLength, SBLevel baseLevel,
+    const SBResourceLimits *limits, SBResolverStatus *status)
+{
+    return PrepareParagraphContext(algorithm, paragraphOffset, suggestedLength, baseLevel,
+                                   limits, status, NULL);
+}
+
+SB_INTERNAL SBResolverStatus SBParagraphResolveContext(ParagraphContextRef context,
+    SBUInteger budget, SBUInteger targetLength)
+{
+    SBParagraphRef paragraph = context->paragraph;
+
+    context->budget = budget;
+
+    while (context->budget != 0 && context->savedLength < targetLength) {
+        switch (context->stage) {
+        case ParagraphStageExplicit:
+            if (!DetermineLevels(context)) {
+                context->stage = ParagraphStageFailed;
+            }
+            break;
+
+        case ParagraphStageIsolating:
+            if (!ResolveIsolatingRuns(context)) {
+                context->stage = ParagraphStageFailed;
+            } else if (context->stage == ParagraphStageExplicit) {
+                /* All queued runs are resolved, so the levels before the next run are final. */
+                SaveLevels(context, context->firstLink);
+            }
+            break;
+
+        case ParagraphStageSaving:
+            SaveLevels(context, context->bidiChain.roller);
+
+            if (paragraph) {
+                paragraph->fixedLevels = context->savedLevels;
+            }
+
+            SB_LOG_BLOCK_OPENER("Determined Embedding Levels");
+            SB_LOG_STATEMENT("Levels", 1, SB_LOG_LEVELS_ARRAY(context->savedLevels, context->savedLength));
+            SB_LOG_BLOCK_CLOSER();
+
+            context->stage = ParagraphStageCompleted;
+            break;
+
+        case ParagraphStageCompleted:
+            return SBResolverStatusCompleted;
+
+        case ParagraphStageExceeded:
+            return SBResolverStatusLimitExceeded;
+
+        default:
+            return SBResolverStatusFailed;
+        }
+    }
+
+    switch (context->stage) {
+    case ParagraphStageCompleted:
+        return SBResolverStatusCompleted;
+
+    case ParagraphStageFailed:
+        return SBResolverStatusFailed;
+
+    case ParagraphStageExceeded:
+        return SBResolverStatusLimitExceeded;
+
+    default:
+        return SBResolverStatusInProgress;
+    }
+}
+
+SB_INTERNAL SBParagraphRef SBParagraphGetContextParagraph(ParagraphContextRef context)
+{
+    return context->paragraph;
+}
+
+SB_INTERNAL SBUInteger SBParagraphGetContextResolvedLength(ParagraphContextRef context)
+{
+    return context->savedLength;
+}
+
+SB_INTERNAL const SBLevel *SBParagraphGetContextLevelsPtr(ParagraphContextRef context)
+{
+    return context->savedLevels;
+}
+
+SB_INTERNAL ParagraphContextRef SBParagraphCreateReusableContext(SBUInteger capacity)
+{
+    return AllocateParagraphContext(capacity, NULL);
+}
+
+SB_INTERNAL SBUInteger SBParagraphMeasureReusableContext(SBUInteger capacity)
+{
+    return MeasureParagraphContext(capacity, SBFalse);
+}
+
+SB_INTERNAL ParagraphContextRef SBParagraphPlaceReusableContext(void *memory, SBUInteger capacity)
+{
+    return PlaceParagraphContext(memory, capacity, NULL);
+}
+
+SB_INTERNAL void SBParagraphFinalizeReusableContext(ParagraphContextRef context)
+{
+    FinalizeParagraphContext(context);
+}
+
+static SBBoolean ResolvePopulatedContext(ParagraphContextRef context,
+    SBAlgorithmRef algorithm, SBUInteger paragraphOffset, SBUInteger paragraphLength,
+    SBLevel baseLevel, SBLevel *levels, SBLevel *resolvedLevel)
+{
+    SBResolverStatus status;
+
+    *resolvedLevel = StartResolution(context, algorithm, paragraphOffset, paragraphLength,
+                                     baseLevel, NULL, levels);
+
+    status = SBParagraphResolveContext(context, UnlimitedBudget, SBInvalidIndex);
+
+    return (status == SBResolverStatusCompleted);
+}
+
+SB_INTERNAL SBBoolean SBParagraphResolveInContext(ParagraphContextRef context,
+    SBAlgorithmRef algorithm, SBUInteger paragraphOffset, SBUInteger paragraphLength,
+    SBLevel baseLevel, SBLevel *levels, SBLevel *resolvedLevel)
+{
+    ResetParagraphContext(context, algorithm->fixedTypes + paragraphOffset, paragraphLength);
+
+    return ResolvePopulatedContext(context, algorithm, paragraphOffset, paragraphLength,
+                                   baseLevel, levels, resolvedLevel);
+}
+
+SB_INTERNAL SBUInteger SBParagraphGetContextRuns(ParagraphContextRef context, SBRun *runs)
+{
+    return SaveRuns(&context->bidiChain, context->baseLevel,
+                    context->isolatingRun.paragraphOffset, runs);
+}
+
+SB_INTERNAL void SBParagraphDisposeContext(ParagraphContextRef context)
+{
+    SBParagraphRelease(context->paragraph);
+    DisposeParagraphContext(context);
+}
+
+SB_INTERNAL SBParagraphRef SBParagraphCreate(SBAlgorithmRef algorithm,
+    SBUInteger paragraphOffset, SBUInteger suggestedLength, SBLevel baseLevel,
+    const SBResourceLimits *limits, SBResolverStatus *status)
+{
+    InlineParagraphContext storage;
+    ParagraphContextRef context;
+    SBParagraphRef paragraph = NULL;
+
+    context = PrepareParagraphContext(algorithm, paragraphOffset, suggestedLength, baseLevel,
+                                      limits, status, &storage);
+
+    if (context) {
+        *status = SBParagraphResolveContext(context, UnlimitedBudget, SBInvalidIndex);
+
+        if (*status == SBResolverStatusCompleted) {
+            paragraph = SBParagraphRetain(context->paragraph);
+        } else {
+            SB_LOG_BREAKER();
+        }
+
+        SBParagraphDisposeContext(context);
+    }
+
+    return paragraph;
+}
+
+static SBBoolean ResolveParagraphPair(SBAlgorithmRef algorithm,
+    SBUInteger paragraphOffset, SBUInteger paragraphLength, SBParagraphRef *paragraphs)
+{
+    InlineParagraphContext storage;
+    SBBoolean isSucceeded = SBFalse;
+    ParagraphContextRef context;
+
+    /*
+     * NOTE:
+     *      Every rule from X1 onwards depends on the base level, so the paragraph is resolved in
+     *      full for each direction, one after the other in the same context.
+     */
+    context = ObtainParagraphContext(paragraphLength, NULL, &storage);
+
+    if (context) {
+        isSucceeded = SBParagraphResolveInContext(context, algorithm, paragraphOffset, paragraphLength,
+                                                  0, paragraphs[0]->fixedLevels + 1,
+                                                  &paragraphs[0]->baseLevel)
+                   && SBParagraphResolveInContext(context, algorithm, paragraphOffset, paragraphLength,
+                                                  1, paragraphs[1]->fixedLevels + 1,
+                                                  &paragraphs[1]->baseLevel);
+
+        DisposeParagraphContext(context);
+    }
+
+    return isSucceeded;
+}
+
+SB_INTERNAL SBBoolean SBParagraphCreatePair(SBAlgorithmRef algorithm,
+    SBUInteger paragraphOffset, SBUInteger suggestedLength,
+    SBParagraphRef *ltrParagraph, SBParagraphRef *rtlParagraph)
+{
+    SBParagraphRef paragraphs[2];
+    SBUInteger actualLength;
+    SBUInteger index;
+
+    actualLength = DetermineBoundary(algorithm, paragraphOffset, suggestedLength);
+
+    paragraphs[0] = AllocateParagraph(algorithm->arena, actualLength);
+    paragraphs[1] = AllocateParagraph(algorithm->arena, actualLength);
+
+    if (paragraphs[0] && paragraphs[1]
+        && ResolveParagraphPair(algorithm, paragraphOffset, actualLength, paragraphs)) {
+        for (index = 0; index < 2; index++) {
+            SBParagraphRef paragraph = paragraphs[index];
+
+            paragraph->algorithm = SBAlgorithmRetain(algorithm);
+            paragraph->refTypes = algorithm->fixedTypes + paragraphOffset;
+            paragraph->fixedLevels += 1;
+            paragraph->offset = paragraphOffset;
+            paragraph->length = actualLength;
+            paragraph->retainCount = 1;
+        }
+
+        *ltrParagraph = paragraphs[0];
+        *rtlParagraph = paragraphs[1];
+
+        return SBTrue;
+    }
+
+    DisposeParagraph(paragraphs[0]);
+    DisposeParagraph(paragraphs[1]);
+
+    SB_LOG_BREAKER();
+
+    return SBFalse;
+}
+
 SBUInteger SBParagraphGetOffset(SBParagraphRef paragraph)
 {
     return paragraph->offset;
@@ -684,9 +1270,159 @@ SBLineRef SBParagraphCreateLine(SBParagraphRef paragraph, SBUInteger lineOffset,
     return NULL;
 }
 
+SBLineRef SBParagraphCreateFittingLine(SBParagraphRef paragraph,
+    SBUInteger lineOffset, const SBUInteger *lineLengths, SBUInteger candidateCount,
+    SBInteger maxWidth, SBRunMeasureFunc measureRun, void *object)
+{
+    SBUInteger paragraphLimit = paragraph->offset + paragraph->length;
+    SBUInteger index;
+
+    if (candidateCount == 0 || lineOffset < paragraph->offset || lineOffset >= paragraphLimit) {
+        return NULL;
+    }
+
+    for (index = 0; index < candidateCount; index++) {
+        SBUInteger lineLength = lineLengths[index];
+
+        if (lineLength == 0 || lineLength > paragraphLimit - lineOffset
+            || (index > 0 && lineLength <= lineLengths[index - 1])) {
+            return NULL;
+        }
+    }
+
+    return SBLineCreateFitting(paragraph, lineOffset, lineLengths, candidateCount,
+                               maxWidth, measureRun, object);
+}
+
+static void CreateLineBatch(void *data)
+{
+    LineBatchRef batch = (LineBatchRef)data;
+    SBUInteger lineOffset = batch->lineOffset;
+    SBUInteger index;
+
+    batch->isSucceeded = SBTrue;
+
+    for (index = 0; index < batch->lineCount; index++) {
+        SBUInteger lineLength = batch->lineLengths[index];
+        SBLineRef line = SBLineCreate(batch->paragraph, lineOffset, lineLength);
+
+        if (!line) {
+            batch->isSucceeded = SBFalse;
+            break;
+        }
+
+        batch->lines[index] = line;
+        lineOffset += lineLength;
+    }
+}
+
+static SBBoolean VerifyLineLengths(SBParagraphRef paragraph,
+    SBUInteger lineOffset, const SBUInteger *lineLengths, SBUInteger lineCount)
+{
+    SBUInteger paragraphLimit = paragraph->offset + paragraph->length;
+    SBUInteger lineLimit = lineOffset;
+    SBUInteger index;
+
+    if (lineOffset < paragraph->offset) {
+        return SBFalse;
+    }
+
+    for (index = 0; index < lineCount; index++) {
+        SBUInteger lineLength = lineLengths[index];
+
+        if (lineLength == 0 || lineLimit >= paragraphLimit || lineLength > paragraphLimit - lineLimit) {
+            return SBFalse;
+        }
+
+        lineLimit += lineLength;
+    }
+
+    return SBTrue;
+}
+
+SBBoolean SBParagraphCreateLinesParallel(SBParagraphRef paragraph,
+    SBUInteger lineOffset, const SBUInteger *lineLengths, SBUInteger lineCount,
+    const SBExecutor *executor, SBLineRef *lines)
+{
+    SBBoolean isSucceeded = SBTrue;
+    LineBatch singleBatch;
+    LineBatchRef batches = NULL;
+    SBUInteger batchCount;
+    SBUInteger index;
+
+    for (index = 0; index < lineCount; index++) {
+        lines[index] = NULL;
+    }
+
+    if (!VerifyLineLengths(paragraph, lineOffset, lineLengths, lineCount)) {
+        return SBFalse;
+    }
+
+    batchCount = SBExecutorGetTaskCount(executor, lineCount);
+
+    /* An arena can't be shared among threads, so its lines are created on the calling thread. */
+    if (batchCount > 1 && !paragraph->arena) {
+        batches = malloc(sizeof(LineBatch) * batchCount);
+    }
+
+    if (batches) {
+        SBUInteger batchOffset = lineOffset;
+        SBUInteger firstLine = 0;
+
+        /* Distribute the lines evenly over the batches. */
+        for (index = 0; index < batchCount; index++) {
+            LineBatchRef batch = &batches[index];
+            SBUInteger limitLine = (lineCount * (index + 1)) / batchCount;
+
+            batch->paragraph = paragraph;
+            batch->lineLengths = lineLengths + firstLine;
+            batch->lines = lines + firstLine;
+            batch->lineOffset = batchOffset;
+            batch->lineCount = limitLine - firstLine;
+            batch->isSucceeded = SBFalse;
+
+            for (; firstLine < limitLine; firstLine++) {
+                batchOffset += lineLengths[firstLine];
+            }
+        }
+
+        for (index = 0; index < batchCount; index++) {
+            SBExecutorSubmitTask(executor, CreateLineBatch, &batches[index]);
+        }
+        SBExecutorWaitTasks(executor);
+
+        for (index = 0; index < batchCount; index++) {
+            if (!batches[index].isSucceeded) {
+                isSucceeded = SBFalse;
+            }
+        }
+
+        free(batches);
+    } else {
+        /* Create all lines on the calling thread. */
+        singleBatch.paragraph = paragraph;
+        singleBatch.lineLengths = lineLengths;
+        singleBatch.lines = lines;
+        singleBatch.lineOffset = lineOffset;
+        singleBatch.lineCount = lineCount;
+
+        CreateLineBatch(&singleBatch);
+        isSucceeded = singleBatch.isSucceeded;
+    }
+
+    if (!isSucceeded) {
+        for (index = 0; index < lineCount; index++) {
+            SBLineRelease(lines[index]);
+            lines[index] = NULL;
+        }
+    }
+
+    return isSucceeded;
+}
+
 SBParagraphRef SBParagraphRetain(SBParagraphRef paragraph)
 {
-    if (paragraph) {
+    if (paragraph && !paragraph->arena) {
         paragraph->retainCount += 1;
     }
     
@@ -695,7 +1431,7 @@ SBParagraphRef SBParagraphRetain(SBParagraphRef paragraph)
 
 void SBParagraphRelease(SBParagraphRef paragraph)
 {
-    if (paragraph && --paragraph->retainCount == 0) {
+    if (paragraph && !paragraph->arena && --paragraph->retainCount == 0) {
         SBAlgorithmRelease(paragraph->algorithm);
         DisposeParagraph(paragraph);
     }
@@ -18,9 +18,12 @@
 #define _SB_INTERNAL_PARAGRAPH_H
 
 #include <SBAlgorithm.h>
+#include <SBArena.h>
 #include <SBBase.h>
 #include <SBConfig.h>
 #include <SBParagraph.h>
+#include <SBResolver.h>
+#include <SBRun.h>
 
 typedef struct _SBParagraph {
     SBAlgorithmRef algorithm;
@@ -29,10 +32,37 @@ typedef struct _SBParagraph {
     SBUInteger offset;
     SBUInteger length;
     SBLevel baseLevel;
+    SBArenaRef arena;
     SBUInteger retainCount;
 } SBParagraph;
 
+typedef struct _ParagraphContext *ParagraphContextRef;
+
 SB_INTERNAL SBParagraphRef SBParagraphCreate(SBAlgorithmRef algorithm,
-    SBUInteger paragraphOffset, SBUInteger suggestedLength, SBLevel baseLevel);
+    SBUInteger paragraphOffset, SBUInteger suggestedLength, SBLevel baseLevel,
+    const SBResourceLimits *limits, SBResolverStatus *status);
+SB_INTERNAL SBBoolean SBParagraphCreatePair(SBAlgorithmRef algorithm,
+    SBUInteger paragraphOffset, SBUInteger suggestedLength,
+    SBParagraphRef *ltrParagraph, SBParagraphRef *rtlParagraph);
+
+SB_INTERNAL ParagraphContextRef SBParagraphCreateContext(SBAlgorithmRef algorithm,
+    SBUInteger paragraphOffset, SBUInteger suggestedLength, SBLevel baseLevel,
+    const SBResourceLimits *limits, SBResolverStatus *status);
+SB_INTERNAL SBResolverStatus SBParagraphResolveContext(ParagraphContextRef context,
+    SBUInteger budget, SBUInteger targetLength);
+SB_INTERNAL SBParagraphRef SBParagraphGetContextParagraph(ParagraphContextRef context);
+SB_INTERNAL SBUInteger SBParagraphGetContextResolvedLength(ParagraphContextRef context);
+SB_INTERNAL const SBLevel *SBParagraphGetContextLevelsPtr(ParagraphContextRef context);
+
+SB_INTERNAL ParagraphContextRef SBParagraphCreateReusableContext(SBUInteger capacity);
+SB_INTERNAL SBUInteger SBParagraphMeasureReusableContext(SBUInteger capacity);
+SB_INTERNAL ParagraphContextRef SBParagraphPlaceReusableContext(void *memory, SBUInteger capacity);
+SB_INTERNAL void SBParagraphFinalizeReusableContext(ParagraphContextRef context);
+SB_INTERNAL SBBoolean SBParagraphResolveInContext(ParagraphContextRef context,
+    SBAlgorithmRef algorithm, SBUInteger paragraphOffset, SBUInteger paragraphLength,
+    SBLevel baseLevel, SBLevel *levels, SBLevel *resolvedLevel);
+SB_INTERNAL SBUInteger SBParagraphGetContextRuns(ParagraphContextRef context, SBRun *runs);
+
+SB_INTERNAL void SBParagraphDisposeContext(ParagraphContextRef context);
 
 #endif
@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <SBConfig.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "SBAlgorithm.h"
+#include "SBBase.h"
+#include "SBLog.h"
+#include "SBParagraph.h"
+#include "SBParagraphRuns.h"
+
+static SBParagraphRunsRef AllocateParagraphRuns(SBUInteger runCount)
+{
+    const SBUInteger sizeParagraphRuns = sizeof(SBParagraphRuns);
+    const SBUInteger sizeRuns          = sizeof(SBRun) * runCount;
+    const SBUInteger sizeMemory        = sizeParagraphRuns + sizeRuns;
+
+    void *pointer = malloc(sizeMemory);
+
+    if (pointer) {
+        const SBUInteger offsetParagraphRuns = 0;
+        const SBUInteger offsetRuns          = offsetParagraphRuns + sizeParagraphRuns;
+
+        SBUInt8 *memory = (SBUInt8 *)pointer;
+        SBParagraphRunsRef paragraphRuns = (SBParagraphRunsRef)(memory + offsetParagraphRuns);
+        SBRun *runs = (SBRun *)(memory + offsetRuns);
+
+        paragraphRuns->fixedRuns = runs;
+        paragraphRuns->runCount = runCount;
+
+        return paragraphRuns;
+    }
+
+    return NULL;
+}
+
+static void DisposeParagraphRuns(SBParagraphRunsRef paragraphRuns)
+{
+    free(paragraphRuns);
+}
+
+SB_INTERNAL SBParagraphRunsRef SBParagraphRunsCreate(SBAlgorithmRef algorithm,
+    SBUInteger paragraphOffset, SBUInteger suggestedLength, SBLevel baseLevel)
+{
+    SBParagraphRunsRef paragraphRuns = NULL;
+    ParagraphContextRef context;
+    SBUInteger actualLength;
+
+    SBAlgorithmGetParagraphBoundary(algorithm, paragraphOffset, suggestedLength, &actualLength, NULL);
+
+    context = SBParagraphCreateReusableContext(actualLength);
+
+    if (context) {
+        SBLevel resolvedLevel;
+
+        /* Resolve the levels within the context only, and keep nothing but the runs. */
+        if (SBParagraphResolveInContext(context, algorithm, paragraphOffset, actualLength,
+                                        baseLevel, NULL, &resolvedLevel)) {
+            SBUInteger runCount = SBParagraphGetContextRuns(context, NULL);
+
+            paragraphRuns = AllocateParagraphRuns(runCount);
+
+            if (paragraphRuns) {
+                SBParagraphGetContextRuns(context, paragraphRuns->fixedRuns);
+
+                paragraphRuns->offset = paragraphOffset;
+                paragraphRuns->length = actualLength;
+                paragraphRuns->baseLevel = resolvedLevel;
+                paragraphRuns->retainCount = 1;
+            }
+        }
+
+        SBParagraphDisposeContext(context);
+    }
+
+    if (!paragraphRuns) {
+        SB_LOG_BREAKER();
+    }
+
+    return paragraphRuns;
+}
+
+SBUInteger SBParagraphRunsGetOffset(SBParagraphRunsRef paragraphRuns)
+{
+    return paragraphRuns->offset;
+}
+
+SBUInteger SBParagraphRunsGetLength(SBParagraphRunsRef paragraphRuns)
+{
+    return paragraphRuns->length;
+}
+
+SBLevel SBParagraphRunsGetBaseLevel(SBParagraphRunsRef paragraphRuns)
+{
+    return paragraphRuns->baseLevel;
+}
+
+SBUInteger SBParagraphRunsGetRunCount(SBParagraphRunsRef paragraphRuns)
+{
+    return paragraphRuns->runCount;
+}
+
+const SBRun *SBParagraphRunsGetRunsPtr(SBParagraphRunsRef paragraphRuns)
+{
+    return paragraphRuns->fixedRuns;
+}
+
+SBLevel SBParagraphRunsGetLevelAt(SBParagraphRunsRef paragraphRuns, SBUInteger index)
+{
+    const SBRun *runs = paragraphRuns->fixedRuns;
+    SBUInteger low = 0;
+    SBUInteger high = paragraphRuns->runCount;
+
+    /* Find the run containing the code unit with a binary search. */
+    while (low < high) {
+        SBUInteger middle = low + (high - low) / 2;
+        const SBRun *run = &runs[middle];
+
+        if (index < run->offset) {
+            high = middle;
+        } else if (index >= run->offset + run->length) {
+            low = middle + 1;
+        } else {
+            return run->level;
+        }
+    }
+
+    return SBLevelInvalid;
+}
+
+void SBParagraphRunsGetOddLevelMask(SBParagraphRunsRef paragraphRuns,
+    SBUInteger maskOffset, SBUInteger maskLength, SBUInt8 *mask)
+{
+    const SBRun *runs = paragraphRuns->fixedRuns;
+    SBUInteger runCount = paragraphRuns->runCount;
+    SBUInteger maskLimit = maskOffset + maskLength;
+    SBUInteger byteCount = (maskLength + 7) / 8;
+    SBUInteger runIndex;
+    SBUInteger index;
+
+    for (index = 0; index < byteCount; index++) {
+        mask[index] = 0;
+    }
+
+    for (runIndex = 0; runIndex < runCount; runIndex++) {
+        const SBRun *run = &runs[runIndex];
+        SBUInteger runStart = run->offset;
+        SBUInteger runEnd = run->offset + run->length;
+
+        if (runEnd <= maskOffset) {
+            continue;
+        }
+        if (runStart >= maskLimit) {
+            break;
+        }
+
+        if (run->level & 1) {
+            SBUInteger start = (runStart > maskOffset ? runStart : maskOffset) - maskOffset;
+            SBUInteger end = (runEnd < maskLimit ? runEnd : maskLimit) - maskOffset;
+
+            for (index = start; index < end; index++) {
+                mask[index >> 3] |= (SBUInt8)(1 << (index & 7));
+            }
+        }
+    }
+}
+
+SBParagraphRunsRef SBParagraphRunsRetain(SBParagraphRunsRef paragraphRuns)
+{
+    if (paragraphRuns) {
+        paragraphRuns->retainCount += 1;
+    }
+
+    return paragraphRuns;
+}
+
+void SBParagraphRunsRelease(SBParagraphRunsRef paragraphRuns)
+{
+    if (paragraphRuns && --paragraphRuns->retainCount == 0) {
+        DisposeParagraphRuns(paragraphRuns);
+    }
+}
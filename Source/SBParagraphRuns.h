@@ -0,0 +1,38 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _SB_INTERNAL_PARAGRAPH_RUNS_H
+#define _SB_INTERNAL_PARAGRAPH_RUNS_H
+
+#include <SBAlgorithm.h>
+#include <SBBase.h>
+#include <SBConfig.h>
+#include <SBParagraphRuns.h>
+#include <SBRun.h>
+
+typedef struct _SBParagraphRuns {
+    SBRun *fixedRuns;
+    SBUInteger runCount;
+    SBUInteger offset;
+    SBUInteger length;
+    SBLevel baseLevel;
+    SBUInteger retainCount;
+} SBParagraphRuns;
+
+SB_INTERNAL SBParagraphRunsRef SBParagraphRunsCreate(SBAlgorithmRef algorithm,
+    SBUInteger paragraphOffset, SBUInteger suggestedLength, SBLevel baseLevel);
+
+#endif
@@ -0,0 +1,385 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <SBConfig.h>
+#include <stddef.h>
+
+#include "SBBase.h"
+#include "SBLine.h"
+#include "SBMirrorLocator.h"
+#include "SBParagraph.h"
+#include "SBRecord.h"
+
+#define RecordMagic     0x52424253
+
+typedef struct _RecordLayout {
+    SBUInteger levelRunCount;
+    SBUInteger lineRunCount;
+    SBUInteger mirrorCount;
+    SBUInteger offsetLevelRuns;
+    SBUInteger offsetLines;
+    SBUInteger offsetLineRuns;
+    SBUInteger offsetMirrors;
+    SBUInteger size;
+} RecordLayout;
+
+static SBBoolean IsUInt32(SBUInteger value)
+{
+    return ((value >> 16) >> 16) == 0;
+}
+
+static SBUInteger CountLevelRuns(SBParagraphRef paragraph, RecordRun *runs)
+{
+    const SBLevel *levels = paragraph->fixedLevels;
+    SBUInteger length = paragraph->length;
+    SBUInteger runCount = 0;
+    SBUInteger index;
+
+    for (index = 0; index < length; index++) {
+        if (index == 0 || levels[index] != levels[index - 1]) {
+            if (runs) {
+                runs[runCount].offset = (SBUInt32)(paragraph->offset + index);
+                runs[runCount].length = 0;
+                runs[runCount].level = levels[index];
+            }
+
+            runCount += 1;
+        }
+
+        if (runs) {
+            runs[runCount - 1].length += 1;
+        }
+    }
+
+    return runCount;
+}
+
+static SBUInteger CountMirrors(SBMirrorLocatorRef locator, SBLineRef line, RecordMirror *mirrors)
+{
+    const SBMirrorAgent *agent = SBMirrorLocatorGetAgent(locator);
+    SBUInteger mirrorCount = 0;
+
+    SBMirrorLocatorLoadLine(locator, line, line->codepointSequence.stringBuffer);
+
+    while (SBMirrorLocatorMoveNext(locator)) {
+        if (mirrors) {
+            mirrors[mirrorCount].index = (SBUInt32)agent->index;
+            mirrors[mirrorCount].mirror = agent->mirror;
+            mirrors[mirrorCount].codepoint = agent->codepoint;
+        }
+
+        mirrorCount += 1;
+    }
+
+    SBMirrorLocatorLoadLine(locator, NULL, NULL);
+
+    return mirrorCount;
+}
+
+static SBBoolean MeasureRecord(SBParagraphRef paragraph, const SBLineRef *lines, SBUInteger lineCount,
+    SBMirrorLocatorRef locator, RecordLayout *layout)
+{
+    SBUInteger paragraphLimit = paragraph->offset + paragraph->length;
+    SBUInteger index;
+
+    layout->levelRunCount = CountLevelRuns(paragraph, NULL);
+    layout->lineRunCount = 0;
+    layout->mirrorCount = 0;
+
+    for (index = 0; index < lineCount; index++) {
+        SBLineRef line = lines[index];
+
+        if (!line || line->offset < paragraph->offset || line->offset + line->length > paragraphLimit) {
+            return SBFalse;
+        }
+
+        layout->lineRunCount += line->runCount;
+        layout->mirrorCount += CountMirrors(locator, line, NULL);
+    }
+
+    layout->offsetLevelRuns = sizeof(RecordHeader);
+    layout->offsetLines = layout->offsetLevelRuns + sizeof(RecordRun) * layout->levelRunCount;
+    layout->offsetLineRuns = layout->offsetLines + sizeof(RecordLine) * lineCount;
+    layout->offsetMirrors = layout->offsetLineRuns + sizeof(RecordRun) * layout->lineRunCount;
+    layout->size = layout->offsetMirrors + sizeof(RecordMirror) * layout->mirrorCount;
+
+    /* Every offset within the record, including its size, must fit in the fields. */
+    return IsUInt32(paragraphLimit) && IsUInt32(layout->size);
+}
+
+static void WriteRecord(SBParagraphRef paragraph, const SBLineRef *lines, SBUInteger lineCount,
+    SBMirrorLocatorRef locator, const RecordLayout *layout, SBUInt8 *memory)
+{
+    RecordHeader *header = (RecordHeader *)memory;
+    RecordLine *recordLines = (RecordLine *)(memory + layout->offsetLines);
+    RecordRun *lineRuns = (RecordRun *)(memory + layout->offsetLineRuns);
+    RecordMirror *mirrors = (RecordMirror *)(memory + layout->offsetMirrors);
+    SBUInteger runIndex = 0;
+    SBUInteger mirrorIndex = 0;
+    SBUInteger index;
+
+    header->magic = RecordMagic;
+    header->version = SBRecordVersion;
+    header->size = (SBUInt32)layout->size;
+    header->offset = (SBUInt32)paragraph->offset;
+    header->length = (SBUInt32)paragraph->length;
+    header->baseLevel = paragraph->baseLevel;
+    header->levelRunCount = (SBUInt32)layout->levelRunCount;
+    header->lineCount = (SBUInt32)lineCount;
+    header->lineRunCount = (SBUInt32)layout->lineRunCount;
+    header->mirrorCount = (SBUInt32)layout->mirrorCount;
+
+    CountLevelRuns(paragraph, (RecordRun *)(memory + layout->offsetLevelRuns));
+
+    for (index = 0; index < lineCount; index++) {
+        SBLineRef line = lines[index];
+        RecordLine *recordLine = &recordLines[index];
+        SBUInteger lineRun;
+
+        recordLine->offset = (SBUInt32)line->offset;
+        recordLine->length = (SBUInt32)line->length;
+        recordLine->runIndex = (SBUInt32)runIndex;
+        recordLine->runCount = (SBUInt32)line->runCount;
+        recordLine->mirrorIndex = (SBUInt32)mirrorIndex;
+
+        for (lineRun = 0; lineRun < line->runCount; lineRun++) {
+            const SBRun *run = &line->fixedRuns[lineRun];
+            RecordRun *recordRun = &lineRuns[runIndex++];
+
+            recordRun->offset = (SBUInt32)run->offset;
+            recordRun->length = (SBUInt32)run->length;
+            recordRun->level = run->level;
+        }
+
+        recordLine->mirrorCount = (SBUInt32)CountMirrors(locator, line, mirrors + mirrorIndex);
+        mirrorIndex += recordLine->mirrorCount;
+    }
+}
+
+SBUInteger SBRecordWrite(SBParagraphRef paragraph, const SBLineRef *lines, SBUInteger lineCount,
+    void *buffer, SBUInteger bufferSize)
+{
+    SBMirrorLocatorRef locator = SBMirrorLocatorCreate();
+    SBUInteger recordSize = 0;
+
+    if (locator) {
+        RecordLayout layout;
+
+        if (MeasureRecord(paragraph, lines, lineCount, locator, &layout)) {
+            recordSize = layout.size;
+
+            if (buffer && bufferSize >= recordSize) {
+                WriteRecord(paragraph, lines, lineCount, locator, &layout, (SBUInt8 *)buffer);
+            }
+        }
+
+        SBMirrorLocatorRelease(locator);
+    }
+
+    return recordSize;
+}
+
+static const RecordHeader *GetHeader(const SBRecordView *view)
+{
+    return (const RecordHeader *)view->_data;
+}
+
+static const RecordRun *GetLevelRuns(const SBRecordView *view)
+{
+    return (const RecordRun *)(GetHeader(view) + 1);
+}
+
+static const RecordLine *GetLines(const SBRecordView *view)
+{
+    return (const RecordLine *)(GetLevelRuns(view) + GetHeader(view)->levelRunCount);
+}
+
+static const RecordRun *GetLineRuns(const SBRecordView *view)
+{
+    return (const RecordRun *)(GetLines(view) + GetHeader(view)->lineCount);
+}
+
+static const RecordMirror *GetMirrors(const SBRecordView *view)
+{
+    return (const RecordMirror *)(GetLineRuns(view) + GetHeader(view)->lineRunCount);
+}
+
+static void ReadRun(const RecordRun *recordRun, SBRun *run)
+{
+    run->offset = recordRun->offset;
+    run->length = recordRun->length;
+    run->level = (SBLevel)recordRun->level;
+}
+
+static SBBoolean VerifyRecord(const RecordHeader *header, SBUInteger dataSize)
+{
+    const RecordLine *lines;
+    SBUInteger size;
+    SBUInteger index;
+
+    if (dataSize < sizeof(RecordHeader)
+        || header->magic != RecordMagic || header->version != SBRecordVersion
+        || header->size > dataSize) {
+        return SBFalse;
+    }
+
+    /* Measure the tables step by step so that corrupt counts can't overflow the size. */
+    size = sizeof(RecordHeader);
+    if (header->levelRunCount > (dataSize - size) / sizeof(RecordRun)) {
+        return SBFalse;
+    }
+    size += sizeof(RecordRun) * header->levelRunCount;
+    if (header->lineCount > (dataSize - size) / sizeof(RecordLine)) {
+        return SBFalse;
+    }
+    size += sizeof(RecordLine) * header->lineCount;
+    if (header->lineRunCount > (dataSize - size) / sizeof(RecordRun)) {
+        return SBFalse;
+    }
+    size += sizeof(RecordRun) * header->lineRunCount;
+    if (header->mirrorCount > (dataSize - size) / sizeof(RecordMirror)) {
+        return SBFalse;
+    }
+    size += sizeof(RecordMirror) * header->mirrorCount;
+
+    if (size != header->size) {
+        return SBFalse;
+    }
+
+    lines = (const RecordLine *)((const RecordRun *)(header + 1) + header->levelRunCount);
+
+    for (index = 0; index < header->lineCount; index++) {
+        const RecordLine *line = &lines[index];
+
+        if (line->runIndex > header->lineRunCount
+            || line->runCount > header->lineRunCount - line->runIndex
+            || line->mirrorIndex > header->mirrorCount
+            || line->mirrorCount > header->mirrorCount - line->mirrorIndex) {
+            return SBFalse;
+        }
+    }
+
+    return SBTrue;
+}
+
+SBBoolean SBRecordViewInitialize(SBRecordView *view, const void *data, SBUInteger dataSize)
+{
+    view->_data = NULL;
+
+    if (data && VerifyRecord((const RecordHeader *)data, dataSize)) {
+        view->_data = data;
+        return SBTrue;
+    }
+
+    return SBFalse;
+}
+
+SBUInteger SBRecordViewGetSize(const SBRecordView *view)
+{
+    return GetHeader(view)->size;
+}
+
+SBUInteger SBRecordViewGetOffset(const SBRecordView *view)
+{
+    return GetHeader(view)->offset;
+}
+
+SBUInteger SBRecordViewGetLength(const SBRecordView *view)
+{
+    return GetHeader(view)->length;
+}
+
+SBLevel SBRecordViewGetBaseLevel(const SBRecordView *view)
+{
+    return (SBLevel)GetHeader(view)->baseLevel;
+}
+
+SBUInteger SBRecordViewGetLevelRunCount(const SBRecordView *view)
+{
+    return GetHeader(view)->levelRunCount;
+}
+
+void SBRecordViewGetLevelRun(const SBRecordView *view, SBUInteger runIndex, SBRun *run)
+{
+    ReadRun(&GetLevelRuns(view)[runIndex], run);
+}
+
+SBLevel SBRecordViewGetLevelAt(const SBRecordView *view, SBUInteger index)
+{
+    const RecordRun *runs = GetLevelRuns(view);
+    SBUInteger low = 0;
+    SBUInteger high = GetHeader(view)->levelRunCount;
+
+    /* Find the run containing the code unit with a binary search. */
+    while (low < high) {
+        SBUInteger middle = low + (high - low) / 2;
+        const RecordRun *run = &runs[middle];
+
+        if (index < run->offset) {
+            high = middle;
+        } else if (index - run->offset >= run->length) {
+            low = middle + 1;
+        } else {
+            return (SBLevel)run->level;
+        }
+    }
+
+    return SBLevelInvalid;
+}
+
+SBUInteger SBRecordViewGetLineCount(const SBRecordView *view)
+{
+    return GetHeader(view)->lineCount;
+}
+
+SBUInteger SBRecordViewGetLineOffset(const SBRecordView *view, SBUInteger lineIndex)
+{
+    return GetLines(view)[lineIndex].offset;
+}
+
+SBUInteger SBRecordViewGetLineLength(const SBRecordView *view, SBUInteger lineIndex)
+{
+    return GetLines(view)[lineIndex].length;
+}
+
+SBUInteger SBRecordViewGetLineRunCount(const SBRecordView *view, SBUInteger lineIndex)
+{
+    return GetLines(view)[lineIndex].runCount;
+}
+
+void SBRecordViewGetLineRun(const SBRecordView *view, SBUInteger lineIndex,
+    SBUInteger runIndex, SBRun *run)
+{
+    const RecordLine *line = &GetLines(view)[lineIndex];
+
+    ReadRun(&GetLineRuns(view)[line->runIndex + runIndex], run);
+}
+
+SBUInteger SBRecordViewGetLineMirrorCount(const SBRecordView *view, SBUInteger lineIndex)
+{
+    return GetLines(view)[lineIndex].mirrorCount;
+}
+
+void SBRecordViewGetLineMirror(const SBRecordView *view, SBUInteger lineIndex,
+    SBUInteger mirrorIndex, SBMirrorAgent *agent)
+{
+    const RecordLine *line = &GetLines(view)[lineIndex];
+    const RecordMirror *mirror = &GetMirrors(view)[line->mirrorIndex + mirrorIndex];
+
+    agent->index = mirror->index;
+    agent->mirror = mirror->mirror;
+    agent->codepoint = mirror->codepoint;
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _SB_INTERNAL_RECORD_H
+#define _SB_INTERNAL_RECORD_H
+
+#include <SBBase.h>
+#include <SBConfig.h>
+#include <SBRecord.h>
+
+/*
+ * NOTE:
+ *      A record consists of a header followed by the level runs of the paragraph, the line table,
+ *      the runs of all lines and the mirrors of all lines. Every field is a 32-bit integer so that
+ *      the tables need no padding and can be read in place.
+ */
+
+typedef struct _RecordHeader {
+    SBUInt32 magic;
+    SBUInt32 version;
+    SBUInt32 size;
+    SBUInt32 offset;
+    SBUInt32 length;
+    SBUInt32 baseLevel;
+    SBUInt32 levelRunCount;
+    SBUInt32 lineCount;
+    SBUInt32 lineRunCount;
+    SBUInt32 mirrorCount;
+} RecordHeader;
+
+typedef struct _RecordRun {
+    SBUInt32 offset;
+    SBUInt32 length;
+    SBUInt32 level;
+} RecordRun;
+
+typedef struct _RecordLine {
+    SBUInt32 offset;
+    SBUInt32 length;
+    SBUInt32 runIndex;
+    SBUInt32 runCount;
+    SBUInt32 mirrorIndex;
+    SBUInt32 mirrorCount;
+} RecordLine;
+
+typedef struct _RecordMirror {
+    SBUInt32 index;
+    SBUInt32 mirror;
+    SBUInt32 codepoint;
+} RecordMirror;
+
+#endif
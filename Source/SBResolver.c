@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <SBConfig.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "SBBase.h"
+#include "SBParagraph.h"
+#include "SBResolver.h"
+
+static void FinishResolution(SBResolverRef resolver)
+{
+    if (resolver->status == SBResolverStatusCompleted) {
+        resolver->paragraph = SBParagraphRetain(SBParagraphGetContextParagraph(resolver->context));
+    }
+
+    /* The context is no longer needed, so release its memory right away. */
+    SBParagraphDisposeContext(resolver->context);
+    resolver->context = NULL;
+}
+
+SB_INTERNAL SBResolverRef SBResolverCreate(SBAlgorithmRef algorithm,
+    SBUInteger paragraphOffset, SBUInteger suggestedLength, SBLevel baseLevel,
+    const SBResourceLimits *limits)
+{
+    SBResolverRef resolver = malloc(sizeof(SBResolver));
+
+    if (resolver) {
+        resolver->context = SBParagraphCreateContext(algorithm, paragraphOffset, suggestedLength,
+                                                     baseLevel, limits, &resolver->status);
+
+        /* A resolver refusing the paragraph up front is still handed over to report the status. */
+        if (resolver->context || resolver->status == SBResolverStatusLimitExceeded) {
+            resolver->paragraph = NULL;
+            resolver->retainCount = 1;
+
+            return resolver;
+        }
+
+        free(resolver);
+    }
+
+    return NULL;
+}
+
+static SBResolverStatus AdvanceResolution(SBResolverRef resolver,
+    SBUInteger budgetLinks, SBUInteger targetLength)
+{
+    if (resolver->status == SBResolverStatusInProgress) {
+        resolver->status = SBParagraphResolveContext(resolver->context, budgetLinks, targetLength);
+
+        if (resolver->status != SBResolverStatusInProgress) {
+            FinishResolution(resolver);
+        }
+    }
+
+    return resolver->status;
+}
+
+SBResolverStatus SBResolverStep(SBResolverRef resolver, SBUInteger budgetLinks)
+{
+    return AdvanceResolution(resolver, budgetLinks, SBInvalidIndex);
+}
+
+SBResolverStatus SBResolverAdvance(SBResolverRef resolver, SBUInteger requestedLength)
+{
+    return AdvanceResolution(resolver, SBInvalidIndex, requestedLength);
+}
+
+SBResolverStatus SBResolverGetStatus(SBResolverRef resolver)
+{
+    return resolver->status;
+}
+
+SBParagraphRef SBResolverGetParagraph(SBResolverRef resolver)
+{
+    return resolver->paragraph;
+}
+
+SBUInteger SBResolverGetResolvedLength(SBResolverRef resolver)
+{
+    if (resolver->paragraph) {
+        return SBParagraphGetLength(resolver->paragraph);
+    }
+    if (resolver->context) {
+        return SBParagraphGetContextResolvedLength(resolver->context);
+    }
+
+    return 0;
+}
+
+const SBLevel *SBResolverGetLevelsPtr(SBResolverRef resolver)
+{
+    if (resolver->paragraph) {
+        return SBParagraphGetLevelsPtr(resolver->paragraph);
+    }
+    if (resolver->context) {
+        return SBParagraphGetContextLevelsPtr(resolver->context);
+    }
+
+    return NULL;
+}
+
+SBResolverRef SBResolverRetain(SBResolverRef resolver)
+{
+    if (resolver) {
+        resolver->retainCount += 1;
+    }
+
+    return resolver;
+}
+
+void SBResolverRelease(SBResolverRef resolver)
+{
+    if (resolver && --resolver->retainCount == 0) {
+        if (resolver->context) {
+            SBParagraphDisposeContext(resolver->context);
+        }
+
+        SBParagraphRelease(resolver->paragraph);
+        free(resolver);
+    }
+}
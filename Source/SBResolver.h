@@ -0,0 +1,39 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _SB_INTERNAL_RESOLVER_H
+#define _SB_INTERNAL_RESOLVER_H
+
+#include <SBAlgorithm.h>
+#include <SBBase.h>
+#include <SBConfig.h>
+#include <SBParagraph.h>
+#include <SBResolver.h>
+
+#include "SBParagraph.h"
+
+typedef struct _SBResolver {
+    ParagraphContextRef context;
+    SBParagraphRef paragraph;
+    SBResolverStatus status;
+    SBUInteger retainCount;
+} SBResolver;
+
+SB_INTERNAL SBResolverRef SBResolverCreate(SBAlgorithmRef algorithm,
+    SBUInteger paragraphOffset, SBUInteger suggestedLength, SBLevel baseLevel,
+    const SBResourceLimits *limits);
+
+#endif
@@ -21,10 +21,56 @@
 #include "PairingLookup.h"
 #include "SBBase.h"
 #include "SBCodepointSequence.h"
+#include "SBExecutor.h"
 #include "ScriptLookup.h"
 #include "ScriptStack.h"
 #include "SBScriptLocator.h"
 
+#define MinimumChunkLength  4096
+#define SplitSearchLimit    256
+
+#define C   0   /* Common script */
+#define L   1   /* Latin script */
+#define X   2   /* Paired punctuation needing the full resolution */
+
+/**
+ * The script classes of ASCII code points, allowing long spans of them to be consumed without any
+ * table lookup.
+ */
+static const SBUInt8 AsciiScriptClasses[128] = {
+    C, C, C, C, C, C, C, C, C, C, C, C, C, C, C, C,  /* 0x00 - 0x0F */
+    C, C, C, C, C, C, C, C, C, C, C, C, C, C, C, C,  /* 0x10 - 0x1F */
+    C, C, C, C, C, C, C, C, X, X, C, C, C, C, C, C,  /* 0x20 - 0x2F */
+    C, C, C, C, C, C, C, C, C, C, C, C, C, C, C, C,  /* 0x30 - 0x3F */
+    C, L, L, L, L, L, L, L, L, L, L, L, L, L, L, L,  /* 0x40 - 0x4F */
+    L, L, L, L, L, L, L, L, L, L, L, X, C, X, C, C,  /* 0x50 - 0x5F */
+    C, L, L, L, L, L, L, L, L, L, L, L, L, L, L, L,  /* 0x60 - 0x6F */
+    L, L, L, L, L, L, L, L, L, L, L, X, C, X, C, C   /* 0x70 - 0x7F */
+};
+
+#undef C
+#undef L
+#undef X
+
+#define AsciiClassCommon    0
+#define AsciiClassLatin     1
+
+typedef struct _RunList {
+    SBScriptAgent *items;
+    SBUInteger count;
+    SBUInteger capacity;
+} RunList, *RunListRef;
+
+typedef struct _ScriptChunk {
+    const SBCodepointSequence *codepointSequence;
+    SBUInteger offset;
+    SBUInteger limit;
+    ScriptStack scriptStack;
+    RunList runList;
+    SBBoolean isExhausted;
+    SBBoolean isSucceeded;
+} ScriptChunk, *ScriptChunkRef;
+
 static SBBoolean IsSimilarScript(SBScript lhs, SBScript rhs)
 {
     return SBScriptIsCommonOrInherited(lhs)
@@ -32,6 +78,161 @@ static SBBoolean IsSimilarScript(SBScript lhs, SBScript rhs)
         || lhs == rhs;
 }
 
+static void InitializeRunList(RunListRef list)
+{
+    list->items = NULL;
+    list->count = 0;
+    list->capacity = 0;
+}
+
+static void FinalizeRunList(RunListRef list)
+{
+    free(list->items);
+}
+
+static SBBoolean AppendRun(RunListRef list, const SBScriptAgent *run)
+{
+    if (list->count > 0) {
+        SBScriptAgent *last = &list->items[list->count - 1];
+
+        /* Merge the runs meeting at a seam if the sequential locator would not break there. */
+        if (last->offset + last->length == run->offset && IsSimilarScript(last->script, run->script)) {
+            last->length += run->length;
+
+            if (SBScriptIsCommonOrInherited(last->script)) {
+                last->script = run->script;
+            }
+
+            return SBTrue;
+        }
+    }
+
+    if (list->count == list->capacity) {
+        SBUInteger capacity = (list->capacity ? list->capacity * 2 : 16);
+        SBScriptAgent *items = realloc(list->items, sizeof(SBScriptAgent) * capacity);
+
+        if (!items) {
+            return SBFalse;
+        }
+
+        list->items = items;
+        list->capacity = capacity;
+    }
+
+    list->items[list->count++] = *run;
+
+    return SBTrue;
+}
+
+static void ClearRuns(SBScriptLocatorRef locator)
+{
+    free(locator->_runs);
+
+    locator->_runs = NULL;
+    locator->_runCount = 0;
+    locator->_runIndex = 0;
+}
+
+static void ClearCheckpoints(SBScriptLocatorRef locator)
+{
+    locator->_checkpointCount = 0;
+    locator->_stackElementCount = 0;
+}
+
+static SBBoolean ReserveCheckpoint(SBScriptLocatorRef locator, SBUInteger elementCount)
+{
+    if (locator->_checkpointCount == locator->_checkpointCapacity) {
+        SBUInteger capacity = (locator->_checkpointCapacity ? locator->_checkpointCapacity * 2 : 16);
+        ScriptCheckpoint *checkpoints = realloc(locator->_checkpoints, sizeof(ScriptCheckpoint) * capacity);
+
+        if (!checkpoints) {
+            return SBFalse;
+        }
+
+        locator->_checkpoints = checkpoints;
+        locator->_checkpointCapacity = capacity;
+    }
+
+    if (locator->_stackElementCount + elementCount > locator->_stackElementCapacity) {
+        SBUInteger capacity = (locator->_stackElementCapacity ? locator->_stackElementCapacity * 2 : 64);
+        _SBScriptStackElement *elements;
+
+        while (capacity < locator->_stackElementCount + elementCount) {
+            capacity *= 2;
+        }
+
+        elements = realloc(locator->_stackElements, sizeof(_SBScriptStackElement) * capacity);
+        if (!elements) {
+            return SBFalse;
+        }
+
+        locator->_stackElements = elements;
+        locator->_stackElementCapacity = capacity;
+    }
+
+    return SBTrue;
+}
+
+/**
+ * Records the state of the stack at the start of a run if it lies at least an interval away from
+ * the last checkpoint. Only the live entries of the stack are kept so that the checkpoints stay
+ * compact.
+ */
+static void RecordCheckpoint(SBScriptLocatorRef locator, SBUInteger offset)
+{
+    SBUInteger interval = locator->_checkpointInterval;
+
+    if (interval) {
+        SBUInteger lastOffset = 0;
+        SBUInteger elementCount;
+
+        if (locator->_checkpointCount > 0) {
+            lastOffset = locator->_checkpoints[locator->_checkpointCount - 1].offset;
+        }
+
+        if (offset < lastOffset + interval) {
+            return;
+        }
+
+        elementCount = ScriptStackGetCount(&locator->_scriptStack);
+
+        /* The checkpoints are an optimization only, so skip the one that could not be stored. */
+        if (ReserveCheckpoint(locator, elementCount)) {
+            ScriptCheckpoint *checkpoint = &locator->_checkpoints[locator->_checkpointCount++];
+
+            checkpoint->offset = offset;
+            checkpoint->elementIndex = locator->_stackElementCount;
+            checkpoint->elementCount = elementCount;
+
+            ScriptStackCopyElements(&locator->_scriptStack,
+                                    &locator->_stackElements[checkpoint->elementIndex]);
+            locator->_stackElementCount += elementCount;
+        }
+    }
+}
+
+/**
+ * Returns the last checkpoint at or before the given offset, or NULL if there is none.
+ */
+static const ScriptCheckpoint *FindCheckpoint(SBScriptLocatorRef locator, SBUInteger offset)
+{
+    const ScriptCheckpoint *checkpoints = locator->_checkpoints;
+    SBUInteger low = 0;
+    SBUInteger high = locator->_checkpointCount;
+
+    while (low < high) {
+        SBUInteger mid = low + (high - low) / 2;
+
+        if (checkpoints[mid].offset <= offset) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return (low > 0 ? &checkpoints[low - 1] : NULL);
+}
+
 SBScriptLocatorRef SBScriptLocatorCreate(void)
 {
     SBScriptLocatorRef locator = malloc(sizeof(SBScriptLocator));
@@ -40,6 +241,15 @@ SBScriptLocatorRef SBScriptLocatorCreate(void)
         locator->_codepointSequence.stringEncoding = SBStringEncodingUTF8;
         locator->_codepointSequence.stringBuffer = NULL;
         locator->_codepointSequence.stringLength = 0;
+        locator->_runs = NULL;
+        locator->_runCount = 0;
+        locator->_checkpoints = NULL;
+        locator->_checkpointCount = 0;
+        locator->_checkpointCapacity = 0;
+        locator->_stackElements = NULL;
+        locator->_stackElementCount = 0;
+        locator->_stackElementCapacity = 0;
+        locator->_checkpointInterval = 0;
         locator->retainCount = 1;
 
         SBScriptLocatorReset(locator);
@@ -50,6 +260,9 @@ SBScriptLocatorRef SBScriptLocatorCreate(void)
 
 void SBScriptLocatorLoadCodepoints(SBScriptLocatorRef locator, const SBCodepointSequence *codepointSequence)
 {
+    ClearRuns(locator);
+    ClearCheckpoints(locator);
+
     locator->_codepointSequence = *codepointSequence;
     SBScriptLocatorReset(locator);
 }
@@ -59,20 +272,82 @@ const SBScriptAgent *SBScriptLocatorGetAgent(SBScriptLocatorRef locator)
     return &locator->agent;
 }
 
-static void ResolveScriptRun(SBScriptLocatorRef locator, SBUInteger offset)
+/**
+ * Skips the ASCII code units whose script class does not exceed the given one.
+ */
+static SBUInteger SkipAsciiUnits(const SBCodepointSequence *sequence,
+    SBUInteger index, SBUInteger limit, SBUInt8 maxClass)
+{
+    switch (sequence->stringEncoding) {
+    case SBStringEncodingUTF8: {
+        const SBUInt8 *buffer = sequence->stringBuffer;
+
+        while (index < limit && buffer[index] < 0x80 && AsciiScriptClasses[buffer[index]] <= maxClass) {
+            index += 1;
+        }
+        break;
+    }
+
+    case SBStringEncodingUTF16: {
+        const SBUInt16 *buffer = sequence->stringBuffer;
+
+        while (index < limit && buffer[index] < 0x80 && AsciiScriptClasses[buffer[index]] <= maxClass) {
+            index += 1;
+        }
+        break;
+    }
+
+    case SBStringEncodingUTF32: {
+        const SBUInt32 *buffer = sequence->stringBuffer;
+
+        while (index < limit && buffer[index] < 0x80 && AsciiScriptClasses[buffer[index]] <= maxClass) {
+            index += 1;
+        }
+        break;
+    }
+    }
+
+    return index;
+}
+
+/**
+ * Resolves a single script run starting at the given offset and ending before the given limit.
+ *
+ * @return
+ *      SBTrue if a closing punctuation could not find its pair in the stack, SBFalse otherwise.
+ */
+static SBBoolean ResolveScriptRun(const SBCodepointSequence *sequence, ScriptStackRef stack,
+    SBUInteger offset, SBUInteger limit, SBScriptAgent *agent)
 {
-    const SBCodepointSequence *sequence = &locator->_codepointSequence;
-    ScriptStackRef stack = &locator->_scriptStack;
+    SBBoolean isExhausted = SBFalse;
     SBScript result = SBScriptZYYY;
     SBUInteger current = offset;
     SBUInteger next = offset;
     SBCodepoint codepoint;
 
     /* Iterate over the code points of specified string buffer. */
-    while ((codepoint = SBCodepointSequenceGetCodepointAt(sequence, &next)) != SBCodepointInvalid) {
+    while (next < limit) {
         SBBoolean isStacked = SBFalse;
         SBScript script;
 
+        /*
+         * Consume the ASCII code points in bulk as long as they can neither change the script of
+         * the run nor affect the stack. The Latin letters can only be consumed once the run has
+         * acquired Latin script.
+         */
+        next = SkipAsciiUnits(sequence, next, limit,
+                              (result == SBScriptLATN ? AsciiClassLatin : AsciiClassCommon));
+        current = next;
+
+        if (next == limit) {
+            break;
+        }
+
+        codepoint = SBCodepointSequenceGetCodepointAt(sequence, &next);
+        if (codepoint == SBCodepointInvalid) {
+            break;
+        }
+
         script = LookupScript(codepoint);
 
         /* Handle paired punctuations in case of a common script. */
@@ -105,6 +380,8 @@ static void ResolveScriptRun(SBScriptLocatorRef locator, SBUInteger offset)
                         isStacked = SBTrue;
                         /* Paired punctuation match the script of enclosing text. */
                         script = ScriptStackGetScript(stack);
+                    } else {
+                        isExhausted = SBTrue;
                     }
                 }
             }
@@ -130,30 +407,342 @@ static void ResolveScriptRun(SBScriptLocatorRef locator, SBUInteger offset)
         current = next;
     }
 
-    ScriptStackLeavePairs(stack);
-
     /* Set the run info in agent. */
-    locator->agent.offset = offset;
-    locator->agent.length = current - offset;
-    locator->agent.script = result;
+    agent->offset = offset;
+    agent->length = current - offset;
+    agent->script = result;
+
+    return isExhausted;
+}
+
+/**
+ * Resolves all script runs of the given range into a list. The pairs of the last run are kept
+ * open so that it can be continued by a following range.
+ */
+static SBBoolean ResolveScriptRuns(const SBCodepointSequence *sequence, ScriptStackRef stack,
+    SBUInteger offset, SBUInteger limit, RunListRef list, SBBoolean *isSucceeded)
+{
+    SBBoolean isExhausted = SBFalse;
+
+    *isSucceeded = SBTrue;
+
+    while (offset < limit) {
+        SBScriptAgent run;
+
+        if (ResolveScriptRun(sequence, stack, offset, limit, &run)) {
+            isExhausted = SBTrue;
+        }
+
+        if (!AppendRun(list, &run)) {
+            *isSucceeded = SBFalse;
+            break;
+        }
+
+        offset += run.length;
+
+        if (offset < limit) {
+            ScriptStackLeavePairs(stack);
+        }
+    }
+
+    return isExhausted;
+}
+
+static void ResolveScriptChunk(void *data)
+{
+    ScriptChunkRef chunk = (ScriptChunkRef)data;
+
+    ScriptStackReset(&chunk->scriptStack);
+
+    chunk->isExhausted = ResolveScriptRuns(chunk->codepointSequence, &chunk->scriptStack,
+                                           chunk->offset, chunk->limit,
+                                           &chunk->runList, &chunk->isSucceeded);
+}
+
+static SBUInteger AlignToCodepoint(const SBCodepointSequence *sequence, SBUInteger index)
+{
+    SBUInteger length = sequence->stringLength;
+
+    /*
+     * The decoders never consume a lead code unit as part of a previous code point, so the
+     * sequential iteration is guaranteed to stop at it.
+     */
+    if (sequence->stringEncoding == SBStringEncodingUTF8) {
+        const SBUInt8 *buffer = sequence->stringBuffer;
+
+        while (index < length && (buffer[index] & 0xC0) == 0x80) {
+            index += 1;
+        }
+    } else if (sequence->stringEncoding == SBStringEncodingUTF16) {
+        const SBUInt16 *buffer = sequence->stringBuffer;
+
+        while (index < length && SBUInt16InRange(buffer[index], 0xDC00, 0xDFFF)) {
+            index += 1;
+        }
+    }
+
+    return index;
+}
+
+static SBUInteger FindSplitPoint(const SBCodepointSequence *sequence, SBUInteger start, SBUInteger limit)
+{
+    SBUInteger splitPoint = SBInvalidIndex;
+    SBUInteger searchCount = 0;
+    SBUInteger next = AlignToCodepoint(sequence, start);
+    SBBoolean isSpaced = SBFalse;
+
+    while (next < limit) {
+        SBUInteger current = next;
+        SBCodepoint codepoint = SBCodepointSequenceGetCodepointAt(sequence, &next);
+        SBGeneralCategory generalCategory;
+
+        if (!SBScriptIsCommonOrInherited(LookupScript(codepoint))) {
+            /* A concrete script after a white space is the most natural seam. */
+            if (isSpaced) {
+                return current;
+            }
+
+            if (splitPoint == SBInvalidIndex) {
+                splitPoint = current;
+            }
+        }
+
+        if (splitPoint != SBInvalidIndex && ++searchCount == SplitSearchLimit) {
+            break;
+        }
+
+        generalCategory = LookupGeneralCategory(codepoint);
+        isSpaced = (SBGeneralCategoryIsSeparator(generalCategory) || generalCategory == SBGeneralCategoryCC);
+    }
+
+    return splitPoint;
+}
+
+static SBUInteger DetermineChunks(const SBCodepointSequence *sequence, ScriptChunkRef chunks, SBUInteger chunkCount)
+{
+    SBUInteger stringLength = sequence->stringLength;
+    SBUInteger offset = 0;
+    SBUInteger count = 0;
+    SBUInteger index;
+
+    for (index = 1; index <= chunkCount; index++) {
+        SBUInteger limit = stringLength;
+
+        if (index < chunkCount) {
+            SBUInteger start = (stringLength / chunkCount) * index;
+            SBUInteger end = (stringLength / chunkCount) * (index + 1);
+
+            if (start <= offset) {
+                continue;
+            }
+
+            limit = FindSplitPoint(sequence, start, end);
+            if (limit == SBInvalidIndex) {
+                continue;
+            }
+        }
+
+        chunks[count].codepointSequence = sequence;
+        chunks[count].offset = offset;
+        chunks[count].limit = limit;
+        InitializeRunList(&chunks[count].runList);
+
+        offset = limit;
+        count += 1;
+    }
+
+    return count;
+}
+
+static SBBoolean StitchChunks(const SBCodepointSequence *sequence,
+    ScriptChunkRef chunks, SBUInteger chunkCount, RunListRef list)
+{
+    ScriptStack scriptStack;
+    SBUInteger index;
+
+    ScriptStackReset(&scriptStack);
+
+    for (index = 0; index < chunkCount; index++) {
+        ScriptChunkRef chunk = &chunks[index];
+        SBBoolean isSucceeded = chunk->isSucceeded;
+        SBUInteger runIndex;
+
+        if (!isSucceeded) {
+            return SBFalse;
+        }
+
+        if (index > 0) {
+            SBScript lastScript = list->items[list->count - 1].script;
+
+            /*
+             * Only a leading run of common script can remain open at a seam as every chunk starts
+             * with a concrete script.
+             */
+            if (!SBScriptIsCommonOrInherited(lastScript)) {
+                ScriptStackLeavePairs(&scriptStack);
+            }
+        }
+
+        if (chunk->isExhausted && !ScriptStackIsEmpty(&scriptStack)) {
+            /*
+             * A closing punctuation of the chunk might pair with an entry preceding it, so resolve
+             * the chunk again while continuing the actual stack.
+             */
+            ResolveScriptRuns(sequence, &scriptStack, chunk->offset, chunk->limit, list, &isSucceeded);
+
+            if (!isSucceeded) {
+                return SBFalse;
+            }
+        } else {
+            if (index > 0 && SBScriptIsCommonOrInherited(list->items[list->count - 1].script)) {
+                ScriptStackSealPairs(&scriptStack, chunk->runList.items[0].script);
+            }
+
+            ScriptStackPlaceOver(&chunk->scriptStack, &scriptStack);
+
+            for (runIndex = 0; runIndex < chunk->runList.count; runIndex++) {
+                if (!AppendRun(list, &chunk->runList.items[runIndex])) {
+                    return SBFalse;
+                }
+            }
+        }
+    }
+
+    return SBTrue;
+}
+
+void SBScriptLocatorLoadCodepointsParallel(SBScriptLocatorRef locator,
+    const SBCodepointSequence *codepointSequence, const SBExecutor *executor)
+{
+    SBUInteger chunkCount;
+    ScriptChunkRef chunks = NULL;
+
+    SBScriptLocatorLoadCodepoints(locator, codepointSequence);
+
+    chunkCount = SBExecutorGetTaskCount(executor, codepointSequence->stringLength / MinimumChunkLength);
+    if (chunkCount > 1) {
+        chunks = malloc(sizeof(ScriptChunk) * chunkCount);
+    }
+
+    if (chunks) {
+        const SBCodepointSequence *sequence = &locator->_codepointSequence;
+        RunList runList;
+        SBUInteger index;
+
+        chunkCount = DetermineChunks(sequence, chunks, chunkCount);
+
+        for (index = 0; index < chunkCount; index++) {
+            SBExecutorSubmitTask(executor, ResolveScriptChunk, &chunks[index]);
+        }
+        SBExecutorWaitTasks(executor);
+
+        InitializeRunList(&runList);
+
+        if (StitchChunks(sequence, chunks, chunkCount, &runList)) {
+            locator->_runs = runList.items;
+            locator->_runCount = runList.count;
+        } else {
+            /* Fall back to the sequential resolution. */
+            FinalizeRunList(&runList);
+        }
+
+        for (index = 0; index < chunkCount; index++) {
+            FinalizeRunList(&chunks[index].runList);
+        }
+
+        free(chunks);
+    }
 }
 
 SBBoolean SBScriptLocatorMoveNext(SBScriptLocatorRef locator)
 {
-    SBUInteger offset = locator->agent.offset + locator->agent.length;
+    if (locator->_runs) {
+        if (locator->_runIndex < locator->_runCount) {
+            locator->agent = locator->_runs[locator->_runIndex++];
+            return SBTrue;
+        }
+    } else {
+        SBUInteger offset = locator->agent.offset + locator->agent.length;
 
-    if (offset < locator->_codepointSequence.stringLength) {
-        ResolveScriptRun(locator, offset);
-        return SBTrue;
+        if (offset < locator->_codepointSequence.stringLength) {
+            RecordCheckpoint(locator, offset);
+            ResolveScriptRun(&locator->_codepointSequence, &locator->_scriptStack,
+                             offset, locator->_codepointSequence.stringLength, &locator->agent);
+            ScriptStackLeavePairs(&locator->_scriptStack);
+            return SBTrue;
+        }
     }
 
     SBScriptLocatorReset(locator);
     return SBFalse;
 }
 
+void SBScriptLocatorSetCheckpointInterval(SBScriptLocatorRef locator, SBUInteger interval)
+{
+    locator->_checkpointInterval = interval;
+}
+
+void SBScriptLocatorSeek(SBScriptLocatorRef locator, SBUInteger offset)
+{
+    SBUInteger stringLength = locator->_codepointSequence.stringLength;
+
+    SBScriptLocatorReset(locator);
+
+    if (locator->_runs) {
+        const SBScriptAgent *runs = locator->_runs;
+        SBUInteger low = 0;
+        SBUInteger high = locator->_runCount;
+
+        /* Find the first run ending after the offset. */
+        while (low < high) {
+            SBUInteger mid = low + (high - low) / 2;
+
+            if (runs[mid].offset + runs[mid].length <= offset) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+
+        locator->_runIndex = low;
+    } else {
+        const SBCodepointSequence *sequence = &locator->_codepointSequence;
+        const ScriptCheckpoint *checkpoint = FindCheckpoint(locator, offset);
+        SBUInteger runOffset = 0;
+
+        if (checkpoint) {
+            ScriptStackLoadElements(&locator->_scriptStack,
+                                    &locator->_stackElements[checkpoint->elementIndex],
+                                    checkpoint->elementCount);
+            runOffset = checkpoint->offset;
+        }
+
+        /* Resolve the runs following the checkpoint until the one containing the offset. */
+        while (runOffset < stringLength) {
+            ScriptStack scriptStack = locator->_scriptStack;
+            SBScriptAgent run;
+
+            RecordCheckpoint(locator, runOffset);
+            ResolveScriptRun(sequence, &locator->_scriptStack, runOffset, stringLength, &run);
+
+            if (runOffset + run.length > offset) {
+                /* Restore the stack so that the run is resolved again by the next move. */
+                locator->_scriptStack = scriptStack;
+                break;
+            }
+
+            ScriptStackLeavePairs(&locator->_scriptStack);
+            runOffset += run.length;
+        }
+
+        locator->agent.offset = runOffset;
+    }
+}
+
 void SBScriptLocatorReset(SBScriptLocatorRef locator)
 {
     ScriptStackReset(&locator->_scriptStack);
+    locator->_runIndex = 0;
     locator->agent.offset = 0;
     locator->agent.length = 0;
     locator->agent.script = SBScriptNil;
@@ -171,6 +760,9 @@ SBScriptLocatorRef SBScriptLocatorRetain(SBScriptLocatorRef locator)
 void SBScriptLocatorRelease(SBScriptLocatorRef locator)
 {
     if (locator && --locator->retainCount == 0) {
+        free(locator->_runs);
+        free(locator->_checkpoints);
+        free(locator->_stackElements);
         free(locator);
     }
 }
@@ -23,9 +23,25 @@
 
 #include "ScriptStack.h"
 
+typedef struct _ScriptCheckpoint {
+    SBUInteger offset;
+    SBUInteger elementIndex;
+    SBUInteger elementCount;
+} ScriptCheckpoint;
+
 typedef struct _SBScriptLocator {
     SBCodepointSequence _codepointSequence;
     ScriptStack _scriptStack;
+    SBScriptAgent *_runs;
+    SBUInteger _runCount;
+    SBUInteger _runIndex;
+    ScriptCheckpoint *_checkpoints;
+    SBUInteger _checkpointCount;
+    SBUInteger _checkpointCapacity;
+    _SBScriptStackElement *_stackElements;
+    SBUInteger _stackElementCount;
+    SBUInteger _stackElementCapacity;
+    SBUInteger _checkpointInterval;
     SBScriptAgent agent;
     SBUInteger retainCount;
 } SBScriptLocator;
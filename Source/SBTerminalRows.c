@@ -0,0 +1,466 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <SBConfig.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "PairingLookup.h"
+#include "SBAlgorithm.h"
+#include "SBBase.h"
+#include "SBCodepointSequence.h"
+#include "SBLine.h"
+#include "SBParagraph.h"
+#include "SBTerminalRows.h"
+
+static SBUInt32 HashRow(const SBTerminalRow *row)
+{
+    SBUInt32 hash = SBHashOffsetBasis;
+    SBUInteger index;
+
+    if (row->generation) {
+        SBUInteger generation = row->generation;
+
+        /* Let a row having a generation be looked up without hashing its contents. */
+        for (index = 0; index < sizeof(SBUInteger); index++) {
+            hash = (hash ^ (SBUInt8)generation) * SBHashPrime;
+            generation >>= 8;
+        }
+    } else {
+        const SBUInt8 *bytes = (const SBUInt8 *)row->cells;
+        SBUInteger byteCount = sizeof(SBCodepoint) * row->cellCount;
+
+        for (index = 0; index < byteCount; index++) {
+            hash = (hash ^ bytes[index]) * SBHashPrime;
+        }
+    }
+
+    return hash;
+}
+
+static SBBoolean IsRowMatching(TerminalEntryRef entry, SBUInt32 hash, const SBTerminalRow *row)
+{
+    if (entry->hash == hash && entry->generation == row->generation
+        && entry->cellCount == row->cellCount) {
+        if (row->cellCount == 0) {
+            return SBTrue;
+        }
+
+        /*
+         * Compare the contents even if the row has a generation, as the generations of different
+         * rows are not required to be distinct.
+         */
+        return (memcmp(entry->cells, row->cells, sizeof(SBCodepoint) * row->cellCount) == 0);
+    }
+
+    return SBFalse;
+}
+
+static TerminalEntryRef FindRow(SBTerminalRowsRef terminalRows, SBUInt32 hash, const SBTerminalRow *row)
+{
+    TerminalEntryRef entry = terminalRows->buckets[hash & (terminalRows->bucketCount - 1)];
+
+    while (entry) {
+        if (IsRowMatching(entry, hash, row)) {
+            return entry;
+        }
+
+        entry = entry->chainNext;
+    }
+
+    return NULL;
+}
+
+static void LinkRow(SBTerminalRowsRef terminalRows, TerminalEntryRef entry)
+{
+    TerminalEntryRef *bucket = &terminalRows->buckets[entry->hash & (terminalRows->bucketCount - 1)];
+
+    entry->chainNext = *bucket;
+    *bucket = entry;
+}
+
+static void UnlinkRow(SBTerminalRowsRef terminalRows, TerminalEntryRef entry)
+{
+    TerminalEntryRef *link = &terminalRows->buckets[entry->hash & (terminalRows->bucketCount - 1)];
+
+    while (*link) {
+        if (*link == entry) {
+            *link = entry->chainNext;
+            break;
+        }
+
+        link = &(*link)->chainNext;
+    }
+
+    entry->chainNext = NULL;
+}
+
+static TerminalEntryRef ObtainFreeEntry(SBTerminalRowsRef terminalRows)
+{
+    TerminalEntryRef oldest = NULL;
+    SBUInteger index;
+
+    if (terminalRows->entryCount < terminalRows->capacity) {
+        return &terminalRows->entries[terminalRows->entryCount++];
+    }
+
+    /* Evict the least recently used entry, leaving the ones provided in current call alone. */
+    for (index = 0; index < terminalRows->capacity; index++) {
+        TerminalEntryRef entry = &terminalRows->entries[index];
+
+        if (entry->lastUse < terminalRows->useCount
+            && (!oldest || entry->lastUse < oldest->lastUse)) {
+            oldest = entry;
+        }
+    }
+
+    if (oldest) {
+        UnlinkRow(terminalRows, oldest);
+    }
+
+    return oldest;
+}
+
+static SBBoolean ReserveCells(TerminalEntryRef entry, SBUInteger cellCount)
+{
+    if (cellCount > entry->cellCapacity) {
+        const SBUInteger sizeMap     = sizeof(SBUInteger) * cellCount;
+        const SBUInteger sizeCells   = sizeof(SBCodepoint) * cellCount;
+        const SBUInteger sizeFlags   = sizeof(SBBoolean) * cellCount;
+        const SBUInteger sizeMemory  = sizeMap + sizeCells + sizeFlags;
+
+        const SBUInteger offsetMap   = 0;
+        const SBUInteger offsetCells = offsetMap + sizeMap;
+        const SBUInteger offsetFlags = offsetCells + sizeCells;
+
+        SBUInt8 *memory;
+
+        free(entry->visualMap);
+        memory = (SBUInt8 *)malloc(sizeMemory);
+
+        if (!memory) {
+            entry->visualMap = NULL;
+            entry->cells = NULL;
+            entry->mirrorFlags = NULL;
+            entry->cellCapacity = 0;
+
+            return SBFalse;
+        }
+
+        entry->visualMap = (SBUInteger *)(memory + offsetMap);
+        entry->cells = (SBCodepoint *)(memory + offsetCells);
+        entry->mirrorFlags = (SBBoolean *)(memory + offsetFlags);
+        entry->cellCapacity = cellCount;
+    }
+
+    return SBTrue;
+}
+
+static SBBoolean ReserveTypes(SBTerminalRowsRef terminalRows, SBUInteger cellCount)
+{
+    if (cellCount > terminalRows->typeCapacity) {
+        free(terminalRows->types);
+        terminalRows->types = (SBBidiType *)malloc(sizeof(SBBidiType) * cellCount);
+
+        if (!terminalRows->types) {
+            terminalRows->typeCapacity = 0;
+            return SBFalse;
+        }
+
+        terminalRows->typeCapacity = cellCount;
+    }
+
+    return SBTrue;
+}
+
+static SBUInteger FillVisualMap(TerminalEntryRef entry, SBLineRef line, SBUInteger visualIndex)
+{
+    SBUInteger runIndex;
+
+    for (runIndex = 0; runIndex < line->runCount; runIndex++) {
+        const SBRun *run = &line->fixedRuns[runIndex];
+        SBUInteger cellIndex;
+
+        if (run->level & 1) {
+            SBBoolean mayMirror = line->fixedMirrorRuns[runIndex];
+
+            cellIndex = run->offset + run->length;
+
+            while (cellIndex-- > run->offset) {
+                entry->visualMap[visualIndex] = cellIndex;
+                entry->mirrorFlags[visualIndex] = (mayMirror && LookupMirror(entry->cells[cellIndex]) != 0);
+                visualIndex += 1;
+            }
+        } else {
+            for (cellIndex = run->offset; cellIndex < run->offset + run->length; cellIndex++) {
+                entry->visualMap[visualIndex] = cellIndex;
+                entry->mirrorFlags[visualIndex] = SBFalse;
+                visualIndex += 1;
+            }
+        }
+    }
+
+    return visualIndex;
+}
+
+static SBBoolean ResolveRow(SBTerminalRowsRef terminalRows, TerminalEntryRef entry)
+{
+    SBUInteger cellCount = entry->cellCount;
+    SBUInteger paragraphOffset = 0;
+    SBUInteger visualIndex = 0;
+    SBCodepointSequence sequence;
+    SBAlgorithm algorithm;
+
+    entry->baseLevel = terminalRows->baseLevel;
+
+    /* An empty row takes the fallback level of the requested base level. */
+    if (entry->baseLevel == SBLevelDefaultLTR) {
+        entry->baseLevel = 0;
+    } else if (entry->baseLevel == SBLevelDefaultRTL) {
+        entry->baseLevel = 1;
+    }
+
+    if (cellCount == 0) {
+        return SBTrue;
+    }
+
+    if (!ReserveTypes(terminalRows, cellCount)) {
+        return SBFalse;
+    }
+
+    sequence.stringEncoding = SBStringEncodingUTF32;
+    sequence.stringBuffer = entry->cells;
+    sequence.stringLength = cellCount;
+
+    SBAlgorithmInitialize(&algorithm, &sequence, terminalRows->types);
+
+    while (paragraphOffset < cellCount) {
+        SBUInteger paragraphLength;
+        SBParagraphRef paragraph;
+        SBLineRef line = NULL;
+
+        SBAlgorithmGetParagraphBoundary(&algorithm, paragraphOffset, cellCount - paragraphOffset,
+                                        &paragraphLength, NULL);
+        paragraph = SBAlgorithmCreateParagraph(&algorithm, paragraphOffset, paragraphLength,
+                                               terminalRows->baseLevel);
+
+        if (paragraph) {
+            if (paragraphOffset == 0) {
+                entry->baseLevel = paragraph->baseLevel;
+            }
+
+            line = SBParagraphCreateLine(paragraph, paragraphOffset, paragraphLength);
+
+            if (line) {
+                visualIndex = FillVisualMap(entry, line, visualIndex);
+                SBLineRelease(line);
+            }
+
+            SBParagraphRelease(paragraph);
+        }
+
+        if (!line) {
+            return SBFalse;
+        }
+
+        paragraphOffset += paragraphLength;
+    }
+
+    return SBTrue;
+}
+
+static SBBoolean FillEntry(SBTerminalRowsRef terminalRows, TerminalEntryRef entry,
+    SBUInt32 hash, const SBTerminalRow *row)
+{
+    if (ReserveCells(entry, row->cellCount)) {
+        if (row->cellCount > 0) {
+            memcpy(entry->cells, row->cells, sizeof(SBCodepoint) * row->cellCount);
+        }
+
+        entry->cellCount = row->cellCount;
+        entry->generation = row->generation;
+        entry->hash = hash;
+
+        return ResolveRow(terminalRows, entry);
+    }
+
+    return SBFalse;
+}
+
+SBTerminalRowsRef SBTerminalRowsCreate(SBUInteger capacity, SBLevel baseLevel)
+{
+    SBUInteger bucketCount = 1;
+
+    if (capacity == 0) {
+        return NULL;
+    }
+
+    while (bucketCount < capacity) {
+        bucketCount <<= 1;
+    }
+
+    {
+        const SBUInteger sizeRows      = sizeof(SBTerminalRows);
+        const SBUInteger sizeEntries   = sizeof(TerminalEntry) * capacity;
+        const SBUInteger sizeBuckets   = sizeof(TerminalEntryRef) * bucketCount;
+        const SBUInteger sizeMemory    = sizeRows + sizeEntries + sizeBuckets;
+
+        const SBUInteger offsetRows    = 0;
+        const SBUInteger offsetEntries = offsetRows + sizeRows;
+        const SBUInteger offsetBuckets = offsetEntries + sizeEntries;
+
+        SBUInt8 *memory = (SBUInt8 *)malloc(sizeMemory);
+
+        if (memory) {
+            SBTerminalRowsRef terminalRows = (SBTerminalRowsRef)(memory + offsetRows);
+            SBUInteger index;
+
+            terminalRows->entries = (TerminalEntryRef)(memory + offsetEntries);
+            terminalRows->buckets = (TerminalEntryRef *)(memory + offsetBuckets);
+            terminalRows->types = NULL;
+            terminalRows->typeCapacity = 0;
+            terminalRows->capacity = capacity;
+            terminalRows->bucketCount = bucketCount;
+            terminalRows->entryCount = 0;
+            terminalRows->useCount = 0;
+            terminalRows->hitCount = 0;
+            terminalRows->missCount = 0;
+            terminalRows->baseLevel = baseLevel;
+            terminalRows->retainCount = 1;
+
+            for (index = 0; index < capacity; index++) {
+                TerminalEntryRef entry = &terminalRows->entries[index];
+
+                entry->chainNext = NULL;
+                entry->visualMap = NULL;
+                entry->cells = NULL;
+                entry->mirrorFlags = NULL;
+                entry->cellCapacity = 0;
+                entry->cellCount = 0;
+                entry->lastUse = 0;
+            }
+
+            for (index = 0; index < bucketCount; index++) {
+                terminalRows->buckets[index] = NULL;
+            }
+
+            return terminalRows;
+        }
+    }
+
+    return NULL;
+}
+
+SBBoolean SBTerminalRowsResolve(SBTerminalRowsRef terminalRows,
+    const SBTerminalRow *rows, SBUInteger rowCount, SBTerminalRowLayout *layouts)
+{
+    SBUInteger index;
+
+    if (rowCount > terminalRows->capacity) {
+        return SBFalse;
+    }
+
+    terminalRows->useCount += 1;
+
+    for (index = 0; index < rowCount; index++) {
+        const SBTerminalRow *row = &rows[index];
+        SBTerminalRowLayout *layout = &layouts[index];
+        SBUInt32 hash = HashRow(row);
+        TerminalEntryRef entry = FindRow(terminalRows, hash, row);
+
+        if (entry) {
+            terminalRows->hitCount += 1;
+        } else {
+            terminalRows->missCount += 1;
+
+            entry = ObtainFreeEntry(terminalRows);
+
+            if (!entry) {
+                return SBFalse;
+            }
+
+            if (!FillEntry(terminalRows, entry, hash, row)) {
+                /* Let the entry be reused first as it is not linked anymore. */
+                entry->lastUse = 0;
+                return SBFalse;
+            }
+
+            LinkRow(terminalRows, entry);
+        }
+
+        entry->lastUse = terminalRows->useCount;
+
+        layout->visualMap = entry->visualMap;
+        layout->mirrorFlags = entry->mirrorFlags;
+        layout->cellCount = entry->cellCount;
+        layout->baseLevel = entry->baseLevel;
+    }
+
+    return SBTrue;
+}
+
+SBUInteger SBTerminalRowsGetHitCount(SBTerminalRowsRef terminalRows)
+{
+    return terminalRows->hitCount;
+}
+
+SBUInteger SBTerminalRowsGetMissCount(SBTerminalRowsRef terminalRows)
+{
+    return terminalRows->missCount;
+}
+
+void SBTerminalRowsClear(SBTerminalRowsRef terminalRows)
+{
+    SBUInteger index;
+
+    /* Keep the memory of the entries so that it is reused by the upcoming rows. */
+    for (index = 0; index < terminalRows->entryCount; index++) {
+        TerminalEntryRef entry = &terminalRows->entries[index];
+
+        entry->chainNext = NULL;
+        entry->lastUse = 0;
+    }
+
+    for (index = 0; index < terminalRows->bucketCount; index++) {
+        terminalRows->buckets[index] = NULL;
+    }
+
+    terminalRows->entryCount = 0;
+}
+
+SBTerminalRowsRef SBTerminalRowsRetain(SBTerminalRowsRef terminalRows)
+{
+    if (terminalRows) {
+        terminalRows->retainCount += 1;
+    }
+
+    return terminalRows;
+}
+
+void SBTerminalRowsRelease(SBTerminalRowsRef terminalRows)
+{
+    if (terminalRows && --terminalRows->retainCount == 0) {
+        SBUInteger index;
+
+        for (index = 0; index < terminalRows->capacity; index++) {
+            free(terminalRows->entries[index].visualMap);
+        }
+
+        free(terminalRows->types);
+        free(terminalRows);
+    }
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _SB_INTERNAL_TERMINAL_ROWS_H
+#define _SB_INTERNAL_TERMINAL_ROWS_H
+
+#include <SBBase.h>
+#include <SBBidiType.h>
+#include <SBCodepoint.h>
+#include <SBConfig.h>
+#include <SBTerminalRows.h>
+
+typedef struct _TerminalEntry {
+    struct _TerminalEntry *chainNext;
+    SBUInteger *visualMap;
+    SBCodepoint *cells;
+    SBBoolean *mirrorFlags;
+    SBUInteger cellCapacity;
+    SBUInteger cellCount;
+    SBUInteger generation;
+    SBUInteger lastUse;
+    SBUInt32 hash;
+    SBLevel baseLevel;
+} TerminalEntry, *TerminalEntryRef;
+
+typedef struct _SBTerminalRows {
+    TerminalEntryRef entries;
+    TerminalEntryRef *buckets;
+    SBBidiType *types;
+    SBUInteger typeCapacity;
+    SBUInteger capacity;
+    SBUInteger bucketCount;
+    SBUInteger entryCount;
+    SBUInteger useCount;
+    SBUInteger hitCount;
+    SBUInteger missCount;
+    SBLevel baseLevel;
+    SBUInteger retainCount;
+} SBTerminalRows;
+
+#endif
@@ -25,6 +25,7 @@ SB_INTERNAL void ScriptStackReset(ScriptStackRef stack)
     stack->top = -1;
     stack->count = 0;
     stack->open = 0;
+    stack->peak = 0;
 }
 
 SB_INTERNAL void ScriptStackPush(ScriptStackRef stack, SBScript script, SBCodepoint mirror)
@@ -35,6 +36,10 @@ SB_INTERNAL void ScriptStackPush(ScriptStackRef stack, SBScript script, SBCodepo
     stack->top = SBNumberRingIncrement(stack->top, _SBScriptStackCapacity);
     stack->_elements[stack->top].script = script;
     stack->_elements[stack->top].mirror = mirror;
+
+    if (stack->count > stack->peak) {
+        stack->peak = stack->count;
+    }
 }
 
 SB_INTERNAL void ScriptStackPop(ScriptStackRef stack)
@@ -67,6 +72,69 @@ SB_INTERNAL void ScriptStackSealPairs(ScriptStackRef stack, SBScript script)
     }
 }
 
+SB_INTERNAL void ScriptStackPlaceOver(ScriptStackRef stack, ScriptStackRef base)
+{
+    SBUInteger baseCount = base->count;
+    SBUInteger index;
+
+    /*
+     * The entries of the stack were pushed while starting from an empty state. Had they been
+     * pushed over the base stack instead, each push exceeding the capacity would have overwritten
+     * the bottommost entry of the base stack. So keep only the base entries that survive the peak
+     * of the stack.
+     */
+    if (baseCount > _SBScriptStackCapacity - stack->peak) {
+        baseCount = _SBScriptStackCapacity - stack->peak;
+    }
+
+    base->count = baseCount;
+    if (baseCount == 0) {
+        base->top = -1;
+    }
+
+    for (index = stack->count; index > 0; index--) {
+        SBInteger element = SBNumberRingSubtract(stack->top, (SBInteger)(index - 1), _SBScriptStackCapacity);
+
+        base->count += 1;
+        base->top = SBNumberRingIncrement(base->top, _SBScriptStackCapacity);
+        base->_elements[base->top] = stack->_elements[element];
+    }
+
+    base->open = stack->open;
+    base->peak = SBNumberGetMax(base->peak, base->count);
+}
+
+SB_INTERNAL SBUInteger ScriptStackGetCount(ScriptStackRef stack)
+{
+    return stack->count;
+}
+
+SB_INTERNAL void ScriptStackCopyElements(ScriptStackRef stack, _SBScriptStackElement *elements)
+{
+    SBUInteger index;
+
+    /* Copy the entries from the bottommost one to the topmost one. */
+    for (index = stack->count; index > 0; index--) {
+        SBInteger element = SBNumberRingSubtract(stack->top, (SBInteger)(index - 1), _SBScriptStackCapacity);
+        *(elements++) = stack->_elements[element];
+    }
+}
+
+SB_INTERNAL void ScriptStackLoadElements(ScriptStackRef stack,
+    const _SBScriptStackElement *elements, SBUInteger count)
+{
+    SBUInteger index;
+
+    ScriptStackReset(stack);
+
+    for (index = 0; index < count; index++) {
+        ScriptStackPush(stack, elements[index].script, elements[index].mirror);
+    }
+
+    /* The loaded entries belong to the runs that have already been resolved. */
+    ScriptStackLeavePairs(stack);
+}
+
 SB_INTERNAL SBBoolean ScriptStackIsEmpty(ScriptStackRef stack)
 {
     return (stack->count == 0);
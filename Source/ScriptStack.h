@@ -32,6 +32,7 @@ typedef struct _SBScriptStack {
     SBInteger top;
     SBUInteger count;
     SBUInteger open;
+    SBUInteger peak;
 } ScriptStack, *ScriptStackRef;
 
 SB_INTERNAL void ScriptStackReset(ScriptStackRef stack);
@@ -42,6 +43,13 @@ SB_INTERNAL void ScriptStackPop(ScriptStackRef stack);
 SB_INTERNAL void ScriptStackLeavePairs(ScriptStackRef stack);
 SB_INTERNAL void ScriptStackSealPairs(ScriptStackRef stack, SBScript script);
 
+SB_INTERNAL void ScriptStackPlaceOver(ScriptStackRef stack, ScriptStackRef base);
+
+SB_INTERNAL SBUInteger ScriptStackGetCount(ScriptStackRef stack);
+SB_INTERNAL void ScriptStackCopyElements(ScriptStackRef stack, _SBScriptStackElement *elements);
+SB_INTERNAL void ScriptStackLoadElements(ScriptStackRef stack,
+    const _SBScriptStackElement *elements, SBUInteger count);
+
 SB_INTERNAL SBBoolean ScriptStackIsEmpty(ScriptStackRef stack);
 SB_INTERNAL SBScript ScriptStackGetScript(ScriptStackRef stack);
 SB_INTERNAL SBCodepoint ScriptStackGetMirror(ScriptStackRef stack);
@@ -28,13 +28,23 @@
 #include "PairingLookup.c"
 #include "RunQueue.c"
 #include "SBAlgorithm.c"
+#include "SBArena.c"
 #include "SBBase.c"
+#include "SBBatch.c"
+#include "SBCache.c"
 #include "SBCodepointSequence.c"
+#include "SBDocument.c"
+#include "SBExecutor.c"
+#include "SBHitIndex.c"
 #include "SBLine.c"
 #include "SBLog.c"
 #include "SBMirrorLocator.c"
 #include "SBParagraph.c"
+#include "SBParagraphRuns.c"
+#include "SBRecord.c"
+#include "SBResolver.c"
 #include "SBScriptLocator.c"
+#include "SBTerminalRows.c"
 #include "ScriptLookup.c"
 #include "ScriptStack.c"
 #include "StatusStack.c"
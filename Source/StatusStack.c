@@ -36,6 +36,8 @@ static SBBoolean StatusStackInsertElement(StatusStackRef stack)
                 return SBFalse;
             }
 
+            stack->allocatedBytes += sizeof(_StatusStackList);
+
             peekList->previous = previousList;
             peekList->next = NULL;
 
@@ -54,6 +56,7 @@ SB_INTERNAL void StatusStackInitialize(StatusStackRef stack)
 {
     stack->_firstList.previous = NULL;
     stack->_firstList.next = NULL;
+    stack->allocatedBytes = 0;
     
     StatusStackSetEmpty(stack);
 }
@@ -41,6 +41,7 @@ typedef struct _StatusStack {
     _StatusStackListRef _peekList;
     SBUInteger _peekTop;
     SBUInteger count;
+    SBUInteger allocatedBytes;
 } StatusStack, *StatusStackRef;
 
 SB_INTERNAL void StatusStackInitialize(StatusStackRef stack);
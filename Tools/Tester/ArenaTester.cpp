@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+extern "C" {
+#include <Headers/SBAlgorithm.h>
+#include <Headers/SBArena.h>
+#include <Headers/SBBase.h>
+#include <Headers/SBLine.h>
+#include <Headers/SBParagraph.h>
+}
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Utilities/BidiText.h"
+#include "Utilities/Document.h"
+#include "Utilities/ThreadExecutor.h"
+
+#include "ArenaTester.h"
+
+using namespace std;
+using namespace SheenBidi::Tester;
+using namespace SheenBidi::Tester::Utilities;
+
+static void arenaTest(const u32string &text, SBUInteger blockSize)
+{
+    Document document(text, SBLevelDefaultLTR);
+    SBArenaRef arena = SBArenaCreate(blockSize);
+    ThreadExecutor executor(4);
+
+    SBAlgorithmRef algorithm = SBAlgorithmCreateInArena(arena, &document.sequence);
+    assert(algorithm != NULL);
+    assert(memcmp(SBAlgorithmGetBidiTypesPtr(algorithm), SBAlgorithmGetBidiTypesPtr(document.algorithm),
+                  sizeof(SBBidiType) * text.length()) == 0);
+
+    /* Retaining and releasing the objects of an arena must have no effect. */
+    assert(SBAlgorithmRetain(algorithm) == algorithm);
+    SBAlgorithmRelease(algorithm);
+    SBAlgorithmRelease(algorithm);
+
+    SBParagraphRef paragraph = SBAlgorithmCreateParagraph(algorithm, 0, text.length(), SBLevelDefaultLTR);
+    SBUInteger length = SBParagraphGetLength(paragraph);
+    assert(length == SBParagraphGetLength(document.paragraph));
+    assert(memcmp(SBParagraphGetLevelsPtr(paragraph), SBParagraphGetLevelsPtr(document.paragraph),
+                  sizeof(SBLevel) * length) == 0);
+
+    SBParagraphRelease(SBParagraphRetain(paragraph));
+    SBParagraphRelease(paragraph);
+
+    /* The lines of an arena paragraph must be equal to the ones of a regular paragraph. */
+    vector<SBUInteger> lengths;
+    for (SBUInteger offset = 0; offset < length; offset += lengths.back()) {
+        lengths.push_back(min((SBUInteger)(lengths.size() * 7 + 3), length - offset));
+    }
+
+    vector<SBLineRef> lines(lengths.size());
+    bool created = SBParagraphCreateLinesParallel(paragraph, 0, lengths.data(), lengths.size(),
+                                                  executor.executor(), lines.data());
+    assert(created);
+
+    SBUInteger offset = 0;
+    for (size_t i = 0; i < lengths.size(); i++) {
+        SBLineRef expected = SBParagraphCreateLine(document.paragraph, offset, lengths[i]);
+        SBLineRef line = SBParagraphCreateLine(paragraph, offset, lengths[i]);
+        assert(BidiText::isEqual(line, expected));
+        assert(BidiText::isEqual(lines[i], expected));
+
+        SBLineRelease(SBLineRetain(line));
+        SBLineRelease(line);
+        SBLineRelease(lines[i]);
+        SBLineRelease(expected);
+
+        offset += lengths[i];
+    }
+
+    assert(SBArenaGetAllocatedBytes(arena) > 0);
+    SBArenaDestroy(arena);
+}
+
+ArenaTester::ArenaTester()
+{
+}
+
+void ArenaTester::test()
+{
+    for (unsigned int seed = 210; seed < 220; seed++) {
+        u32string text = BidiText::generate(seed, 40 + seed % 7 * 60);
+
+        /* Test with blocks smaller than the objects as well as with the default size. */
+        arenaTest(text, 64);
+        arenaTest(text, 1000);
+        arenaTest(text, 0);
+    }
+
+    SBArenaDestroy(NULL);
+}
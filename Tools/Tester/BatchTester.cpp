@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+extern "C" {
+#include <Headers/SBAlgorithm.h>
+#include <Headers/SBBase.h>
+#include <Headers/SBBatch.h>
+#include <Headers/SBCodepointSequence.h>
+#include <Headers/SBDocument.h>
+#include <Headers/SBLine.h>
+#include <Headers/SBParagraph.h>
+#include <Headers/SBRun.h>
+}
+
+#include <cassert>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Utilities/BidiText.h"
+
+#include "BatchTester.h"
+
+using namespace std;
+using namespace SheenBidi::Tester;
+using namespace SheenBidi::Tester::Utilities;
+
+static void batchTest(const vector<u32string> &texts, SBLevel baseLevel)
+{
+    vector<SBCodepointSequence> sequences(texts.size());
+
+    for (size_t i = 0; i < texts.size(); i++) {
+        sequences[i].stringEncoding = SBStringEncodingUTF32;
+        sequences[i].stringBuffer = (void *)texts[i].data();
+        sequences[i].stringLength = texts[i].length();
+    }
+
+    SBBatchResults results;
+    bool resolved = SBResolveBatch(sequences.data(), sequences.size(), baseLevel, &results);
+    assert(resolved);
+    assert(results.entryCount == texts.size());
+
+    SBUInteger levelOffset = 0;
+    SBUInteger runOffset = 0;
+
+    for (size_t i = 0; i < texts.size(); i++) {
+        const SBBatchEntry &entry = results.entries[i];
+        const u32string &text = texts[i];
+
+        assert(entry.levelOffset == levelOffset);
+        assert(entry.length == text.length());
+        assert(entry.runOffset == runOffset);
+
+        if (!text.empty()) {
+            /* Compare the levels and the runs with the ones of the individual APIs. */
+            SBAlgorithmRef algorithm = SBAlgorithmCreate(&sequences[i]);
+            SBDocumentRef document = SBAlgorithmResolveAll(algorithm, baseLevel);
+            const SBParagraphInfo *paragraphs = SBDocumentGetParagraphsPtr(document);
+            SBUInteger paragraphCount = SBDocumentGetParagraphCount(document);
+            const SBRun *runs = results.runs + entry.runOffset;
+            SBUInteger runIndex = 0;
+
+            assert(entry.baseLevel == paragraphs[0].baseLevel);
+            assert(memcmp(results.levels + entry.levelOffset, SBDocumentGetLevelsPtr(document),
+                          sizeof(SBLevel) * text.length()) == 0);
+
+            for (SBUInteger j = 0; j < paragraphCount; j++) {
+                SBParagraphRef paragraph = SBAlgorithmCreateParagraph(algorithm,
+                    paragraphs[j].offset, paragraphs[j].length, baseLevel);
+                SBLineRef line = SBParagraphCreateLine(paragraph, paragraphs[j].offset, paragraphs[j].length);
+                const SBRun *expected = SBLineGetRunsPtr(line);
+                SBUInteger expectedCount = SBLineGetRunCount(line);
+
+                for (SBUInteger k = 0; k < expectedCount; k++, runIndex++) {
+                    assert(runs[runIndex].offset == expected[k].offset);
+                    assert(runs[runIndex].length == expected[k].length);
+                    assert(runs[runIndex].level == expected[k].level);
+                }
+
+                SBLineRelease(line);
+                SBParagraphRelease(paragraph);
+            }
+            assert(runIndex == entry.runCount);
+
+            SBDocumentRelease(document);
+            SBAlgorithmRelease(algorithm);
+        } else {
+            assert(entry.runCount == 0);
+        }
+
+        levelOffset += entry.length;
+        runOffset += entry.runCount;
+    }
+    assert(results.levelCount == levelOffset);
+    assert(results.runCount == runOffset);
+
+    SBBatchResultsFinalize(&results);
+    assert(results._memory == NULL && results.entryCount == 0);
+}
+
+BatchTester::BatchTester()
+{
+}
+
+void BatchTester::test()
+{
+    vector<u32string> texts;
+
+    /* Test with many short strings, including empty and multi-paragraph ones. */
+    for (unsigned int seed = 100; seed < 200; seed++) {
+        texts.push_back(BidiText::generate(seed, seed % 40));
+    }
+    texts.push_back(U"abc\n\u05D0\u05D1 (123)\r\n\u202Bxyz");
+    texts.push_back(BidiText::generate(200, 400));
+
+    batchTest(texts, SBLevelDefaultLTR);
+    batchTest(texts, SBLevelDefaultRTL);
+    batchTest(texts, 1);
+
+    /* Test an empty batch and an invalid sequence. */
+    batchTest({ }, SBLevelDefaultLTR);
+
+    SBCodepointSequence invalid = { SBStringEncodingUTF32, NULL, 4 };
+    SBBatchResults results;
+    assert(!SBResolveBatch(&invalid, 1, SBLevelDefaultLTR, &results));
+    assert(results._memory == NULL);
+}
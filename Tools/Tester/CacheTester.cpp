@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+extern "C" {
+#include <Headers/SBBase.h>
+#include <Headers/SBCache.h>
+#include <Headers/SBCodepointSequence.h>
+#include <Headers/SBLine.h>
+#include <Headers/SBParagraph.h>
+}
+
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Utilities/BidiText.h"
+#include "Utilities/Document.h"
+
+#include "CacheTester.h"
+
+using namespace std;
+using namespace SheenBidi::Tester;
+using namespace SheenBidi::Tester::Utilities;
+
+static void lockMutex(void *object)
+{
+    static_cast<mutex *>(object)->lock();
+}
+
+static void unlockMutex(void *object)
+{
+    static_cast<mutex *>(object)->unlock();
+}
+
+static vector<u32string> generateTexts()
+{
+    vector<u32string> texts;
+
+    for (unsigned int seed = 220; seed < 240; seed++) {
+        texts.push_back(BidiText::generate(seed, 10 + seed % 50));
+    }
+
+    return texts;
+}
+
+CacheTester::CacheTester()
+{
+}
+
+void CacheTester::test()
+{
+    testLookup();
+    testStringSharing();
+    testEviction();
+    testThreads();
+    testSharedLine();
+}
+
+void CacheTester::testLookup()
+{
+    SBCacheRef cache = SBCacheCreate(1 << 20, NULL);
+    vector<u32string> texts = generateTexts();
+
+    /* Test that the cached results match the regular ones and are shared on a hit. */
+    for (const auto &text : texts) {
+        u32string copy = text;
+        SBCodepointSequence sequence = BidiText::makeSequence(copy);
+        Document document(text, SBLevelDefaultRTL);
+
+        SBParagraphRef first = SBCacheGetParagraph(cache, &sequence, SBLevelDefaultRTL);
+        /* The cache must not depend on the source string once a lookup returns. */
+        copy.assign(copy.length(), U'x');
+        copy = text;
+        SBParagraphRef second = SBCacheGetParagraph(cache, &sequence, SBLevelDefaultRTL);
+        SBLineRef line = SBCacheGetLine(cache, &sequence, SBLevelDefaultRTL);
+        SBLineRef expected = SBParagraphCreateLine(document.paragraph, 0, text.length());
+
+        assert(first == second);
+        assert(SBParagraphGetBaseLevel(first) == SBParagraphGetBaseLevel(document.paragraph));
+        assert(memcmp(SBParagraphGetLevelsPtr(first), SBParagraphGetLevelsPtr(document.paragraph),
+                      sizeof(SBLevel) * text.length()) == 0);
+        assert(BidiText::isEqual(line, expected));
+        assert(SBCacheGetLine(cache, &sequence, SBLevelDefaultRTL) == line);
+
+        SBCacheReleaseLine(cache, line);
+        SBCacheReleaseLine(cache, line);
+        SBCacheReleaseParagraph(cache, second);
+        SBCacheReleaseParagraph(cache, first);
+        SBLineRelease(expected);
+    }
+
+    assert(SBCacheGetMissCount(cache) == texts.size());
+    assert(SBCacheGetHitCount(cache) == texts.size() * 3);
+    assert(SBCacheGetEntryCount(cache) == texts.size());
+
+    /* The base level must be a part of the key. */
+    SBCodepointSequence sequence = BidiText::makeSequence(texts[0]);
+    SBParagraphRef paragraph = SBCacheGetParagraph(cache, &sequence, 1);
+    assert(SBParagraphGetBaseLevel(paragraph) == 1);
+    assert(SBCacheGetMissCount(cache) == texts.size() + 1);
+    SBCacheReleaseParagraph(cache, paragraph);
+
+    SBCacheRelease(cache);
+}
+
+void CacheTester::testStringSharing()
+{
+    /* Test that a cached line shares the string of its paragraph and keeps it alive. */
+    SBCacheRef cache = SBCacheCreate(1 << 20, NULL);
+    u32string longText(2000, U'a');
+    longText += U" שלום";
+    SBCodepointSequence sequence = BidiText::makeSequence(longText);
+    SBCacheReleaseParagraph(cache, SBCacheGetParagraph(cache, &sequence, SBLevelDefaultLTR));
+    SBUInteger paragraphBytes = SBCacheGetUsedBytes(cache);
+    SBLineRef line = SBCacheGetLine(cache, &sequence, SBLevelDefaultLTR);
+    assert(SBCacheGetUsedBytes(cache) - paragraphBytes < sizeof(SBCodepoint) * longText.length());
+
+    SBCacheClear(cache);
+    assert(SBCacheGetEntryCount(cache) == 0 && SBCacheGetUsedBytes(cache) == 0);
+
+    u32string visual(longText.length(), U'\0');
+    SBLineCopyVisualString(line, SBStringEncodingUTF32, &visual[0], visual.length());
+    assert(visual == u32string(2000, U'a') + U" םולש");
+    SBLineRelease(line);
+    SBCacheRelease(cache);
+}
+
+void CacheTester::testEviction()
+{
+    /* Test that the least recently used strings are evicted within the budget. */
+    const SBUInteger budget = 2048;
+    SBCacheRef cache = SBCacheCreate(budget, NULL);
+    vector<u32string> texts = generateTexts();
+    SBCodepointSequence sequence = BidiText::makeSequence(texts[0]);
+
+    SBCacheReleaseParagraph(cache, SBCacheGetParagraph(cache, &sequence, SBLevelDefaultLTR));
+
+    for (size_t i = 1; i < texts.size(); i++) {
+        SBCodepointSequence other = BidiText::makeSequence(texts[i]);
+        SBCacheReleaseParagraph(cache, SBCacheGetParagraph(cache, &other, SBLevelDefaultLTR));
+        /* Keep the first string in use. */
+        SBCacheReleaseParagraph(cache, SBCacheGetParagraph(cache, &sequence, SBLevelDefaultLTR));
+
+        assert(SBCacheGetUsedBytes(cache) <= budget);
+    }
+    assert(SBCacheGetEntryCount(cache) < texts.size());
+    assert(SBCacheGetMissCount(cache) == texts.size());
+
+    SBCacheRelease(cache);
+}
+
+void CacheTester::testThreads()
+{
+    /* Test a cache shared among threads. */
+    mutex lock;
+    SBCacheLock cacheLock = { &lock, lockMutex, unlockMutex };
+    SBCacheRef cache = SBCacheCreate(4096, &cacheLock);
+    vector<u32string> texts = generateTexts();
+    vector<thread> threads;
+
+    for (unsigned int t = 0; t < 4; t++) {
+        threads.emplace_back([&texts, cache, t]() {
+            for (size_t i = 0; i < 200; i++) {
+                const u32string &text = texts[(i * (t + 1)) % texts.size()];
+                SBCodepointSequence sequence = BidiText::makeSequence(text);
+                SBLineRef line = SBCacheGetLine(cache, &sequence, SBLevelDefaultLTR);
+
+                assert(line != NULL && SBLineGetLength(line) == text.length());
+                SBCacheReleaseLine(cache, line);
+            }
+        });
+    }
+    for (auto &worker : threads) {
+        worker.join();
+    }
+
+    assert(SBCacheGetHitCount(cache) + SBCacheGetMissCount(cache) == 800);
+    SBCacheRelease(cache);
+}
+
+void CacheTester::testSharedLine()
+{
+    /* Test threads asking for the line of a string whose paragraph alone is cached. */
+    mutex lock;
+    SBCacheLock cacheLock = { &lock, lockMutex, unlockMutex };
+    SBCacheRef cache = SBCacheCreate(1 << 20, &cacheLock);
+    u32string text = BidiText::generate(240, 2000);
+    SBCodepointSequence sequence = BidiText::makeSequence(text);
+    vector<SBLineRef> lines(4);
+    vector<thread> threads;
+    atomic<bool> isStarted(false);
+
+    SBParagraphRef paragraph = SBCacheGetParagraph(cache, &sequence, SBLevelDefaultLTR);
+    SBUInteger length = SBParagraphGetLength(paragraph);
+    SBCacheReleaseParagraph(cache, paragraph);
+
+    for (size_t t = 0; t < lines.size(); t++) {
+        threads.emplace_back([&lines, &sequence, &isStarted, cache, t]() {
+            while (!isStarted) {
+                this_thread::yield();
+            }
+            lines[t] = SBCacheGetLine(cache, &sequence, SBLevelDefaultLTR);
+        });
+    }
+    isStarted = true;
+    for (auto &worker : threads) {
+        worker.join();
+    }
+
+    for (SBLineRef line : lines) {
+        assert(line == lines[0] && SBLineGetLength(line) == length);
+        SBCacheReleaseLine(cache, line);
+    }
+    assert(SBCacheGetMissCount(cache) == 1);
+    assert(SBCacheGetHitCount(cache) == lines.size());
+    SBCacheRelease(cache);
+}
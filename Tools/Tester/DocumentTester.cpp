@@ -0,0 +1,235 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+extern "C" {
+#include <Headers/SBAlgorithm.h>
+#include <Headers/SBBase.h>
+#include <Headers/SBCodepointSequence.h>
+#include <Headers/SBDocument.h>
+#include <Headers/SBParagraph.h>
+}
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Utilities/BidiText.h"
+#include "Utilities/Document.h"
+
+#include "DocumentTester.h"
+
+using namespace std;
+using namespace SheenBidi::Tester;
+using namespace SheenBidi::Tester::Utilities;
+
+static void documentTest(const u32string &text, SBLevel baseLevel)
+{
+    SBCodepointSequence sequence = BidiText::makeSequence(text);
+    SBAlgorithmRef algorithm = SBAlgorithmCreate(&sequence);
+    SBDocumentRef document = SBAlgorithmResolveAll(algorithm, baseLevel);
+    assert(document != NULL);
+    assert(SBDocumentGetLength(document) == text.length());
+
+    const SBParagraphInfo *paragraphs = SBDocumentGetParagraphsPtr(document);
+    const SBLevel *levels = SBDocumentGetLevelsPtr(document);
+    SBUInteger paragraphCount = SBDocumentGetParagraphCount(document);
+    SBUInteger offset = 0;
+
+    for (SBUInteger i = 0; i < paragraphCount; i++) {
+        SBParagraphRef paragraph = SBAlgorithmCreateParagraph(algorithm, offset, text.length() - offset, baseLevel);
+        SBUInteger length = SBParagraphGetLength(paragraph);
+
+        assert(paragraphs[i].offset == offset);
+        assert(paragraphs[i].length == length);
+        assert(paragraphs[i].baseLevel == SBParagraphGetBaseLevel(paragraph));
+        assert(memcmp(levels + offset, SBParagraphGetLevelsPtr(paragraph), sizeof(SBLevel) * length) == 0);
+
+        SBParagraphRelease(paragraph);
+        offset += length;
+    }
+    assert(offset == text.length());
+
+    SBDocumentRelease(document);
+    SBAlgorithmRelease(algorithm);
+}
+
+template<class Char>
+static void variantTest(const basic_string<Char> &text, SBStringEncoding encoding,
+                        SBUInteger offset, SBUInteger oldLength, const basic_string<Char> &insertion)
+{
+    basic_string<Char> edited = text;
+    edited.replace(offset, oldLength, insertion);
+
+    SBCodepointSequence baseSequence = { encoding, (void *)text.data(), text.length() };
+    SBCodepointSequence insertSequence = { encoding, (void *)insertion.data(), insertion.length() };
+    SBCodepointSequence editedSequence = { encoding, (void *)edited.data(), edited.length() };
+
+    SBAlgorithmRef base = SBAlgorithmCreate(&baseSequence);
+    SBAlgorithmRef variant = SBAlgorithmCreateVariant(base, offset, oldLength, &insertSequence);
+    SBAlgorithmRef expected = SBAlgorithmCreate(&editedSequence);
+    assert(variant != NULL && expected != NULL);
+
+    /* The variant must classify the edited string exactly like a fresh algorithm. */
+    const SBBidiType *types = SBAlgorithmGetBidiTypesPtr(variant);
+    assert(equal(types, types + edited.length(), SBAlgorithmGetBidiTypesPtr(expected)));
+
+    SBUInteger editOffset;
+    SBUInteger editLength;
+    SBAlgorithmGetEditedRange(variant, &editOffset, &editLength);
+
+    SBUInteger editLimit = editOffset + editLength;
+    SBUInteger baseLimit = editLimit - edited.length() + text.length();
+    assert(editOffset <= offset && editLimit >= offset + insertion.length());
+    assert(editLimit <= edited.length());
+
+    /* Resolve only the edited paragraphs and take the rest from the original document. */
+    SBDocumentRef baseDocument = SBAlgorithmResolveAll(base, SBLevelDefaultLTR);
+    SBDocumentRef expectedDocument = SBAlgorithmResolveAll(expected, SBLevelDefaultLTR);
+    const SBLevel *baseLevels = SBDocumentGetLevelsPtr(baseDocument);
+    vector<SBLevel> levels(edited.length());
+
+    copy(baseLevels, baseLevels + editOffset, levels.begin());
+    copy(baseLevels + baseLimit, baseLevels + text.length(), levels.begin() + editLimit);
+
+    for (SBUInteger index = editOffset; index < editLimit; ) {
+        SBParagraphRef paragraph = SBAlgorithmCreateParagraph(variant, index, editLimit - index,
+                                                              SBLevelDefaultLTR);
+        SBUInteger length = SBParagraphGetLength(paragraph);
+        const SBLevel *paragraphLevels = SBParagraphGetLevelsPtr(paragraph);
+
+        copy(paragraphLevels, paragraphLevels + length, levels.begin() + index);
+        index += length;
+
+        SBParagraphRelease(paragraph);
+    }
+
+    assert(equal(levels.begin(), levels.end(), SBDocumentGetLevelsPtr(expectedDocument)));
+
+    /* No paragraph of the edited string may cross the boundaries of the edited range. */
+    const SBParagraphInfo *paragraphs = SBDocumentGetParagraphsPtr(expectedDocument);
+
+    for (SBUInteger i = 0; i < SBDocumentGetParagraphCount(expectedDocument); i++) {
+        SBUInteger paragraphLimit = paragraphs[i].offset + paragraphs[i].length;
+
+        assert(!(paragraphs[i].offset < editOffset && paragraphLimit > editOffset));
+        assert(!(paragraphs[i].offset < editLimit && paragraphLimit > editLimit));
+    }
+
+    SBDocumentRelease(expectedDocument);
+    SBDocumentRelease(baseDocument);
+    SBAlgorithmRelease(expected);
+    SBAlgorithmRelease(variant);
+    SBAlgorithmRelease(base);
+}
+
+DocumentTester::DocumentTester()
+{
+}
+
+void DocumentTester::test()
+{
+    testDocument();
+    testVariant();
+}
+
+void DocumentTester::testDocument()
+{
+    const u32string separators[] = { U"\n", U"\r\n", U"\r", U"\u2029", U"\u001C" };
+    u32string text;
+
+    /* Test with paragraphs of varying lengths separated by all kinds of separators. */
+    for (unsigned int seed = 20; seed < 60; seed++) {
+        text += BidiText::generate(seed, (seed * 37) % 300);
+        text += separators[seed % 5];
+    }
+
+    documentTest(text, SBLevelDefaultLTR);
+    documentTest(text, SBLevelDefaultRTL);
+    documentTest(text, 1);
+
+    /* Test without a trailing separator and with consecutive separators. */
+    documentTest(U"\u05D0bc\n\n\r\nabc \u2067\u05D0", SBLevelDefaultLTR);
+    documentTest(U"a", SBLevelDefaultRTL);
+}
+
+void DocumentTester::testVariant()
+{
+    const u32string text = U"abc אבג def\nsecond (ד) line\r\nthird ١٢";
+    const SBUInteger secondOffset = text.find(U's');
+    const SBUInteger thirdOffset = text.find(U't', secondOffset + 6);
+
+    /* Test edits within a paragraph and around its boundaries. */
+    variantTest(text, SBStringEncodingUTF32, 4, 0, u32string(U"بة"));
+    variantTest(text, SBStringEncodingUTF32, secondOffset + 7, 3, u32string(U"\u202Bx"));
+    variantTest(text, SBStringEncodingUTF32, secondOffset - 1, 1, u32string());
+    variantTest(text, SBStringEncodingUTF32, secondOffset + 3, 0, u32string(U"\n"));
+    variantTest(text, SBStringEncodingUTF32, secondOffset, 0, u32string(U"ה\n"));
+    variantTest(text, SBStringEncodingUTF32, thirdOffset - 1, 0, u32string(U"x"));
+    variantTest(text, SBStringEncodingUTF32, thirdOffset - 2, 0, u32string(U"\r"));
+    variantTest(text, SBStringEncodingUTF32, secondOffset - 1, 0, u32string(U"\r"));
+    variantTest(text, SBStringEncodingUTF32, 2, thirdOffset, u32string(U"z"));
+    variantTest(text, SBStringEncodingUTF32, 0, 0, u32string(U"א"));
+    variantTest(text, SBStringEncodingUTF32, text.length(), 0, u32string(U"\n"));
+    variantTest(text, SBStringEncodingUTF32, text.length() - 1, 1, u32string());
+
+    /* Test edits splitting the code points of UTF-16 and UTF-8 strings. */
+    const u16string utf16 = u"a\U0001F600bא\nc\U00010900";
+    variantTest(utf16, SBStringEncodingUTF16, 2, 0, u16string(u"ב"));
+    variantTest(utf16, SBStringEncodingUTF16, 1, 1, u16string(u"\U00010900"));
+    variantTest(utf16, SBStringEncodingUTF16, 7, 1, u16string(u"\xD800"));
+    variantTest(utf16, SBStringEncodingUTF16, 6, 1, u16string(u"\xDC00"));
+
+    const string utf8 = "a\xD7\x90\xC2\x85" "b\xE2\x80\xA9" "c";
+    variantTest(utf8, SBStringEncodingUTF8, 2, 0, string("x"));
+    variantTest(utf8, SBStringEncodingUTF8, 4, 1, string("\x90"));
+    variantTest(utf8, SBStringEncodingUTF8, 3, 0, string("\xD7"));
+    variantTest(utf8, SBStringEncodingUTF8, 7, 2, string("\n"));
+
+    /* Test random edits of random text. */
+    for (unsigned int seed = 250; seed < 280; seed++) {
+        mt19937 generator(seed);
+        u32string random = BidiText::generate(seed, 80);
+
+        for (size_t i = 0; i < 4; i++) {
+            random[generator() % random.length()] = (i % 2 ? U'\n' : U'\r');
+        }
+
+        SBUInteger offset = generator() % random.length();
+        SBUInteger oldLength = generator() % (random.length() - offset + 1) % 12;
+        u32string insertion = BidiText::generate(seed + 1000, generator() % 6);
+
+        if (seed % 3 == 0) {
+            insertion.push_back(U'\n');
+        }
+
+        variantTest(random, SBStringEncodingUTF32, offset, oldLength, insertion);
+    }
+
+    /* Test invalid edits. */
+    SBCodepointSequence sequence = BidiText::makeSequence(text);
+    SBCodepointSequence mismatch = { SBStringEncodingUTF8, (void *)"x", 1 };
+    SBAlgorithmRef algorithm = SBAlgorithmCreate(&sequence);
+
+    assert(SBAlgorithmCreateVariant(algorithm, text.length() + 1, 0, NULL) == NULL);
+    assert(SBAlgorithmCreateVariant(algorithm, 2, text.length(), NULL) == NULL);
+    assert(SBAlgorithmCreateVariant(algorithm, 0, text.length(), NULL) == NULL);
+    assert(SBAlgorithmCreateVariant(algorithm, 0, 0, &mismatch) == NULL);
+
+    SBAlgorithmRelease(algorithm);
+}
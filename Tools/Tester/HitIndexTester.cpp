@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+extern "C" {
+#include <Headers/SBAlgorithm.h>
+#include <Headers/SBBase.h>
+#include <Headers/SBCodepointSequence.h>
+#include <Headers/SBHitIndex.h>
+#include <Headers/SBLine.h>
+#include <Headers/SBParagraph.h>
+#include <Headers/SBRun.h>
+}
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Utilities/BidiText.h"
+#include "Utilities/Document.h"
+
+#include "HitIndexTester.h"
+
+using namespace std;
+using namespace SheenBidi::Tester;
+using namespace SheenBidi::Tester::Utilities;
+
+static void hitIndexTest(const u32string &text, SBLevel baseLevel, uint32_t seed)
+{
+    Document document(text, baseLevel);
+    SBLineRef line = SBParagraphCreateLine(document.paragraph, 0, text.length());
+    SBUInteger runCount = SBLineGetRunCount(line);
+    const SBRun *runs = SBLineGetRunsPtr(line);
+    mt19937 generator(seed);
+
+    vector<SBInteger> advances(text.length());
+    for (auto &advance : advances) {
+        advance = generator() % 4;
+    }
+
+    /* Lay out the code units in visual order one by one. */
+    vector<SBUInteger> visualUnits;
+    vector<bool> reversedUnits;
+    for (SBUInteger i = 0; i < runCount; i++) {
+        for (SBUInteger j = 0; j < runs[i].length; j++) {
+            bool isReversed = runs[i].level & 1;
+            visualUnits.push_back(isReversed ? runs[i].offset + runs[i].length - j - 1 : runs[i].offset + j);
+            reversedUnits.push_back(isReversed);
+        }
+    }
+
+    SBHitIndexRef hitIndex = SBHitIndexCreate(line, advances.data());
+    SBInteger width = 0;
+
+    for (SBUInteger i = 0; i < visualUnits.size(); i++) {
+        SBUInteger unit = visualUnits[i];
+        SBInteger left = width;
+        SBInteger right = width + advances[unit];
+
+        /* Test the caret at the leading edge of the code unit. */
+        assert(SBHitIndexGetCaretPosition(hitIndex, unit) == (reversedUnits[i] ? right : left));
+
+        /* Test the hits inside the code unit. */
+        for (SBInteger position = left; position < right; position++) {
+            SBBoolean isTrailing = SBFalse;
+            bool isRightHalf = (position - left >= right - position);
+
+            assert(SBHitIndexGetOffsetAtPosition(hitIndex, position, &isTrailing) == unit);
+            assert(isTrailing == (reversedUnits[i] ? !isRightHalf : isRightHalf));
+        }
+
+        width = right;
+    }
+
+    assert(SBHitIndexGetWidth(hitIndex) == width);
+
+    /* Test the positions and offsets beyond the edges of the line. */
+    if (!visualUnits.empty()) {
+        SBUInteger last = text.length() - 1;
+        SBUInteger lastVisual = find(visualUnits.begin(), visualUnits.end(), last) - visualUnits.begin();
+        SBInteger trailingEdge = SBHitIndexGetCaretPosition(hitIndex, last);
+        trailingEdge += (reversedUnits[lastVisual] ? -advances[last] : advances[last]);
+
+        assert(SBHitIndexGetCaretPosition(hitIndex, text.length()) == trailingEdge);
+
+        /* The positions beyond the edges must fall on the outermost units having an advance. */
+        auto hasAdvance = [&advances](SBUInteger unit) { return advances[unit] != 0; };
+        auto leftmost = find_if(visualUnits.begin(), visualUnits.end(), hasAdvance);
+        auto rightmost = find_if(visualUnits.rbegin(), visualUnits.rend(), hasAdvance);
+
+        if (leftmost != visualUnits.end()) {
+            assert(SBHitIndexGetOffsetAtPosition(hitIndex, width + 10, NULL) == *rightmost);
+            assert(SBHitIndexGetOffsetAtPosition(hitIndex, -10, NULL) == *leftmost);
+        }
+    }
+
+    SBHitIndexRelease(hitIndex);
+    SBLineRelease(line);
+}
+
+HitIndexTester::HitIndexTester()
+{
+}
+
+void HitIndexTester::test()
+{
+    hitIndexTest(U"abc def", 0, 1);
+    hitIndexTest(U"אבג דהו", 1, 2);
+    hitIndexTest(U"abc אבג 123 def", 0, 3);
+    hitIndexTest(U"abc אבג 123 def", 1, 4);
+
+    for (unsigned int seed = 470; seed < 500; seed++) {
+        u32string text = BidiText::generate(seed, 150);
+
+        hitIndexTest(text, SBLevelDefaultLTR, seed);
+        hitIndexTest(text, 1, seed);
+    }
+
+    /* Test that the edges do not fall on the trailing units of the code points. */
+    u16string utf16 = u"\U00010900\U00010901 a\U0001F600";
+    SBCodepointSequence sequence = { SBStringEncodingUTF16, (void *)utf16.data(), utf16.length() };
+    SBAlgorithmRef algorithm = SBAlgorithmCreate(&sequence);
+
+    for (SBLevel baseLevel : { 0, 1 }) {
+        SBParagraphRef paragraph = SBAlgorithmCreateParagraph(algorithm, 0, utf16.length(), baseLevel);
+        SBLineRef line = SBParagraphCreateLine(paragraph, 0, utf16.length());
+        const SBInteger advances[] = { 3, 0, 3, 0, 1, 2, 4, 0 };
+        SBHitIndexRef hitIndex = SBHitIndexCreate(line, advances);
+
+        assert(SBHitIndexGetOffsetAtPosition(hitIndex, -10, NULL) == (baseLevel ? 6 : 2));
+        assert(SBHitIndexGetOffsetAtPosition(hitIndex, 100, NULL) == (baseLevel ? 0 : 6));
+
+        SBHitIndexRelease(hitIndex);
+        SBLineRelease(line);
+        SBParagraphRelease(paragraph);
+    }
+
+    SBAlgorithmRelease(algorithm);
+}
@@ -0,0 +1,458 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+extern "C" {
+#include <Headers/SBAlgorithm.h>
+#include <Headers/SBBase.h>
+#include <Headers/SBCodepoint.h>
+#include <Headers/SBCodepointSequence.h>
+#include <Headers/SBLine.h>
+#include <Headers/SBMirrorLocator.h>
+#include <Headers/SBParagraph.h>
+#include <Headers/SBRun.h>
+}
+
+#include <algorithm>
+#include <cassert>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Utilities/BidiText.h"
+#include "Utilities/Document.h"
+
+#include "LineTester.h"
+
+using namespace std;
+using namespace SheenBidi::Tester;
+using namespace SheenBidi::Tester::Utilities;
+
+static SBUInteger matchTest(const u32string &text, SBUInteger offset, SBUInteger oldLength,
+                            const u32string &insertion)
+{
+    u32string edited = text;
+    edited.replace(offset, oldLength, insertion);
+
+    Document previous(text, SBLevelDefaultLTR);
+    Document current(edited, SBLevelDefaultLTR);
+    SBLineRef previousLine = SBParagraphCreateLine(previous.paragraph, 0, text.length());
+    SBLineRef line = SBParagraphCreateLine(current.paragraph, 0, edited.length());
+
+    const SBRun *previousRuns = SBLineGetRunsPtr(previousLine);
+    const SBRun *runs = SBLineGetRunsPtr(line);
+    SBUInteger previousCount = SBLineGetRunCount(previousLine);
+    SBUInteger runCount = SBLineGetRunCount(line);
+    SBUInteger editLimit = offset + insertion.length();
+
+    vector<SBUInteger> matches(runCount);
+    SBUInteger changeCount = SBLineMatchRuns(line, previousLine, offset, oldLength,
+                                             insertion.length(), matches.data());
+    assert(SBLineMatchRuns(line, previousLine, offset, oldLength, insertion.length(), NULL) == changeCount);
+
+    vector<bool> used(previousCount, false);
+    SBUInteger unmatchedCount = 0;
+
+    for (SBUInteger i = 0; i < runCount; i++) {
+        const SBRun &run = runs[i];
+        bool overlaps = run.offset < editLimit && run.offset + run.length > offset;
+        SBUInteger previousOffset = run.offset;
+
+        if (previousOffset >= editLimit) {
+            previousOffset = previousOffset - insertion.length() + oldLength;
+        }
+
+        if (matches[i] == SBRunMatchNone) {
+            /* An unmatched run must either overlap the edit or be really new. */
+            unmatchedCount += 1;
+
+            for (SBUInteger j = 0; j < previousCount && !overlaps; j++) {
+                const SBRun &candidate = previousRuns[j];
+                assert(!(candidate.offset == previousOffset && candidate.length == run.length
+                         && candidate.level == run.level));
+            }
+        } else {
+            const SBRun &match = previousRuns[matches[i]];
+
+            assert(!overlaps);
+            assert(!used[matches[i]]);
+            assert(match.offset == previousOffset && match.length == run.length && match.level == run.level);
+
+            used[matches[i]] = true;
+        }
+    }
+    assert(unmatchedCount == changeCount);
+
+    SBLineRelease(line);
+    SBLineRelease(previousLine);
+
+    return changeCount;
+}
+
+template<class Char>
+static vector<SBCodepoint> decodeString(const Char *buffer, SBUInteger length, SBStringEncoding encoding)
+{
+    SBCodepointSequence sequence = { encoding, (void *)buffer, length };
+    vector<SBCodepoint> codepoints;
+    SBUInteger index = 0;
+    SBCodepoint codepoint;
+
+    while ((codepoint = SBCodepointSequenceGetCodepointAt(&sequence, &index)) != SBCodepointInvalid) {
+        codepoints.push_back(codepoint);
+    }
+
+    return codepoints;
+}
+
+template<class Char>
+static void visualStringTest(const basic_string<Char> &text, SBStringEncoding encoding)
+{
+    SBCodepointSequence sequence = { encoding, (void *)text.data(), text.length() };
+    SBAlgorithmRef algorithm = SBAlgorithmCreate(&sequence);
+    SBParagraphRef paragraph = SBAlgorithmCreateParagraph(algorithm, 0, text.length(), SBLevelDefaultLTR);
+    SBLineRef line = SBParagraphCreateLine(paragraph, 0, SBParagraphGetLength(paragraph));
+
+    /* Build the expected visual string by walking the runs. */
+    const SBRun *runs = SBLineGetRunsPtr(line);
+    vector<SBCodepoint> expected;
+
+    for (SBUInteger i = 0; i < SBLineGetRunCount(line); i++) {
+        vector<SBCodepoint> codepoints = decodeString(text.data() + runs[i].offset, runs[i].length, encoding);
+
+        if (runs[i].level & 1) {
+            reverse(codepoints.begin(), codepoints.end());
+
+            for (SBCodepoint &codepoint : codepoints) {
+                SBCodepoint mirror = SBCodepointGetMirror(codepoint);
+                if (mirror) {
+                    codepoint = mirror;
+                }
+            }
+        }
+
+        expected.insert(expected.end(), codepoints.begin(), codepoints.end());
+    }
+
+    /* Check the output in every encoding. */
+    SBUInteger utf8Length = SBLineCopyVisualString(line, SBStringEncodingUTF8, NULL, 0);
+    SBUInteger utf16Length = SBLineCopyVisualString(line, SBStringEncodingUTF16, NULL, 0);
+    SBUInteger utf32Length = SBLineCopyVisualString(line, SBStringEncodingUTF32, NULL, 0);
+    vector<SBUInt8> utf8(utf8Length + 1, 0xFF);
+    vector<SBUInt16> utf16(utf16Length + 1, 0xFFFF);
+    vector<SBUInt32> utf32(utf32Length + 1, 0xFFFFFFFF);
+
+    assert(utf32Length == expected.size());
+    assert(SBLineCopyVisualString(line, SBStringEncodingUTF8, utf8.data(), utf8Length - 1) == utf8Length);
+    assert(utf8[0] == 0xFF);
+
+    SBLineCopyVisualString(line, SBStringEncodingUTF8, utf8.data(), utf8Length);
+    SBLineCopyVisualString(line, SBStringEncodingUTF16, utf16.data(), utf16Length);
+    SBLineCopyVisualString(line, SBStringEncodingUTF32, utf32.data(), utf32Length);
+
+    assert(utf8[utf8Length] == 0xFF && utf16[utf16Length] == 0xFFFF && utf32[utf32Length] == 0xFFFFFFFF);
+    assert(decodeString(utf8.data(), utf8Length, SBStringEncodingUTF8) == expected);
+    assert(decodeString(utf16.data(), utf16Length, SBStringEncodingUTF16) == expected);
+    assert(vector<SBCodepoint>(utf32.begin(), utf32.end() - 1) == expected);
+    assert(SBLineCopyVisualString(line, 3, NULL, 0) == 0);
+
+    SBLineRelease(line);
+    SBParagraphRelease(paragraph);
+    SBAlgorithmRelease(algorithm);
+}
+
+static void bulkMirrorTest(const u32string &text, SBLevel baseLevel)
+{
+    Document document(text, baseLevel);
+    SBLineRef line = SBParagraphCreateLine(document.paragraph, 0, text.length());
+
+    vector<SBMirrorAgent> expected;
+    SBMirrorLocatorRef locator = SBMirrorLocatorCreate();
+    SBMirrorLocatorLoadLine(locator, line, document.sequence.stringBuffer);
+    const SBMirrorAgent *agent = SBMirrorLocatorGetAgent(locator);
+    while (SBMirrorLocatorMoveNext(locator)) {
+        expected.push_back(*agent);
+    }
+    SBMirrorLocatorRelease(locator);
+
+    /* Test that the agents are written only within the capacity. */
+    SBUInteger mirrorCount = SBLineGetMirrors(line, NULL, 0);
+    vector<SBMirrorAgent> agents(mirrorCount + 1, { 0, 0, 0 });
+    assert(mirrorCount == expected.size());
+    assert(SBLineGetMirrors(line, agents.data(), mirrorCount / 2) == mirrorCount);
+    assert(agents[mirrorCount / 2].mirror == 0);
+    assert(SBLineGetMirrors(line, agents.data(), agents.size()) == mirrorCount);
+    assert(agents[mirrorCount].mirror == 0);
+
+    for (size_t i = 0; i < expected.size(); i++) {
+        assert(agents[i].index == expected[i].index);
+        assert(agents[i].mirror == expected[i].mirror);
+        assert(agents[i].codepoint == expected[i].codepoint);
+    }
+
+    /* Test the mirroring of a buffer in logical order. */
+    u32string logical = text;
+    u32string mirrored = text;
+    for (const auto &e : expected) {
+        mirrored[e.index] = e.mirror;
+    }
+    assert(SBLineApplyMirroring(line, (SBCodepoint *)&logical[0], NULL) == mirrorCount);
+    assert(logical == mirrored);
+
+    /* Test the mirroring of a buffer in reversed order through an index map. */
+    u32string reversed(text.rbegin(), text.rend());
+    vector<SBUInteger> indexMap(text.length());
+    for (size_t i = 0; i < text.length(); i++) {
+        indexMap[i] = text.length() - i - 1;
+    }
+    assert(SBLineApplyMirroring(line, (SBCodepoint *)&reversed[0], indexMap.data()) == mirrorCount);
+    assert(reversed == u32string(mirrored.rbegin(), mirrored.rend()));
+
+    SBLineRelease(line);
+}
+
+static void visualRangeTest(const u32string &text, SBLevel baseLevel,
+    SBUInteger lineOffset, SBUInteger lineLength, SBUInteger offset, SBUInteger length)
+{
+    Document document(text, baseLevel);
+    SBLineRef line = SBParagraphCreateLine(document.paragraph, lineOffset, lineLength);
+    SBUInteger runCount = SBLineGetRunCount(line);
+    const SBRun *runs = SBLineGetRunsPtr(line);
+
+    /* Mark the selected code units in visual order one by one. */
+    vector<bool> selected;
+    for (SBUInteger i = 0; i < runCount; i++) {
+        for (SBUInteger j = 0; j < runs[i].length; j++) {
+            SBUInteger index = (runs[i].level & 1
+                                ? runs[i].offset + runs[i].length - j - 1
+                                : runs[i].offset + j);
+            selected.push_back(index >= offset && index - offset < length);
+        }
+    }
+
+    vector<SBVisualRange> expected;
+    for (SBUInteger i = 0; i < selected.size(); i++) {
+        if (selected[i]) {
+            if (!expected.empty() && expected.back().offset + expected.back().length == i) {
+                expected.back().length += 1;
+            } else {
+                expected.push_back({ i, 1 });
+            }
+        }
+    }
+
+    SBUInteger rangeCount = SBLineGetVisualRangesForLogicalRange(line, offset, length, NULL, 0);
+    vector<SBVisualRange> ranges(rangeCount + 1, { 0, 0 });
+    assert(rangeCount == expected.size());
+    assert(SBLineGetVisualRangesForLogicalRange(line, offset, length,
+                                                ranges.data(), ranges.size()) == rangeCount);
+    assert(ranges[rangeCount].length == 0);
+
+    for (SBUInteger i = 0; i < rangeCount; i++) {
+        assert(ranges[i].offset == expected[i].offset);
+        assert(ranges[i].length == expected[i].length);
+    }
+
+    SBLineRelease(line);
+}
+
+static void itemsTest(const u32string &text, SBLevel baseLevel, const vector<SBUInteger> &attributes)
+{
+    Document document(text, baseLevel);
+    SBLineRef line = SBParagraphCreateLine(document.paragraph, 0, text.length());
+    SBUInteger runCount = SBLineGetRunCount(line);
+    const SBRun *runs = SBLineGetRunsPtr(line);
+
+    /* Split the runs code unit by code unit in visual order. */
+    vector<SBLineItem> expected;
+    for (SBUInteger i = 0; i < runCount; i++) {
+        bool isReversed = runs[i].level & 1;
+
+        for (SBUInteger j = 0; j < runs[i].length; j++) {
+            SBUInteger index = (isReversed ? runs[i].offset + runs[i].length - j - 1 : runs[i].offset + j);
+            SBUInteger attribute = 0;
+            while (attribute + 1 < attributes.size() && attributes[attribute + 1] <= index) {
+                attribute++;
+            }
+
+            SBLineItem *last = (expected.empty() || j == 0 ? nullptr : &expected.back());
+            if (last && last->attributeIndex == attribute) {
+                last->length += 1;
+                if (isReversed) {
+                    last->offset -= 1;
+                }
+            } else {
+                expected.push_back({ index, 1, attribute, runs[i].level });
+            }
+        }
+    }
+
+    SBUInteger itemCount = SBLineGetItems(line, attributes.data(), attributes.size(), NULL, 0);
+    vector<SBLineItem> items(itemCount + 1, { 0, 0, 0, 0 });
+    assert(itemCount == expected.size());
+    assert(SBLineGetItems(line, attributes.data(), attributes.size(),
+                          items.data(), items.size()) == itemCount);
+    assert(items[itemCount].length == 0);
+
+    for (SBUInteger i = 0; i < itemCount; i++) {
+        assert(items[i].offset == expected[i].offset);
+        assert(items[i].length == expected[i].length);
+        assert(items[i].attributeIndex == expected[i].attributeIndex);
+        assert(items[i].level == expected[i].level);
+    }
+
+    SBLineRelease(line);
+}
+
+LineTester::LineTester()
+{
+}
+
+void LineTester::test()
+{
+    testRunMatching();
+    testVisualString();
+    testBulkMirrors();
+    testVisualRanges();
+    testItems();
+}
+
+void LineTester::testRunMatching()
+{
+    const u32string text = U"abc אבג def גדה xyz";
+
+    /* Test edits affecting a single run. */
+    assert(matchTest(text, 17, 1, U"q") == 1);
+    assert(matchTest(text, 5, 1, U"ט") == 1);
+    assert(matchTest(text, 5, 0, U"טט") == 1);
+    assert(matchTest(text, 0, 0, U"w") == 1);
+    assert(matchTest(text, text.length(), 0, U"w") == 1);
+
+    /* Test edits changing the structure of runs. */
+    assert(matchTest(text, 9, 0, U"ו") == 3);
+    assert(matchTest(text, 4, 11, U"") == 1);
+    assert(matchTest(text, 0, 0, U"\u202E") > 1);
+    assert(matchTest(text, 0, 0, U"") == 0);
+
+    /* Test lines of the same text resolved separately and with different base levels. */
+    Document ltr(text, 0);
+    Document other(text, 0);
+    Document rtl(text, 1);
+    SBLineRef ltrLine = SBParagraphCreateLine(ltr.paragraph, 0, text.length());
+    SBLineRef otherLine = SBParagraphCreateLine(other.paragraph, 0, text.length());
+    SBLineRef rtlLine = SBParagraphCreateLine(rtl.paragraph, 0, text.length());
+
+    assert(SBLineMatchRuns(otherLine, ltrLine, 0, 0, 0, NULL) == 0);
+    assert(SBLineMatchRuns(rtlLine, ltrLine, 0, 0, 0, NULL) == SBLineGetRunCount(rtlLine));
+
+    SBLineRelease(otherLine);
+    SBLineRelease(rtlLine);
+    SBLineRelease(ltrLine);
+
+    /* Test random edits of random text. */
+    for (unsigned int seed = 280; seed < 320; seed++) {
+        mt19937 generator(seed);
+        u32string random = BidiText::generate(seed, 60);
+        SBUInteger offset = generator() % (random.length() + 1);
+        SBUInteger oldLength = generator() % (random.length() - offset + 1) % 8;
+        u32string insertion = BidiText::generate(seed + 1000, generator() % 4);
+
+        matchTest(random, offset, oldLength, insertion);
+    }
+}
+
+void LineTester::testVisualString()
+{
+    visualStringTest(u32string(U"abc (אב [ג]) def"), SBStringEncodingUTF32);
+    visualStringTest(u32string(U"אבג (x < y) \U00010900\U00010901 «12»"), SBStringEncodingUTF32);
+    visualStringTest(u16string(u"a \U0001F600 (\U00010900\U00010901) b"), SBStringEncodingUTF16);
+    visualStringTest(string(u8"א (بة) €\U0001F600 x"), SBStringEncodingUTF8);
+    visualStringTest(string("a\xD7\x90\xFF\xD7\x91 b"), SBStringEncodingUTF8);
+
+    for (const auto &text : BidiText::generate(320, 10, 100)) {
+        visualStringTest(text, SBStringEncodingUTF32);
+    }
+}
+
+void LineTester::testBulkMirrors()
+{
+    bulkMirrorTest(U"abc def", 1);
+    bulkMirrorTest(U"(abc) [def]", 0);
+    bulkMirrorTest(U"שלום (עולם) [אב] {גד} <הו>", 1);
+    bulkMirrorTest(U"abc (אב) [def] {גד}", 0);
+    bulkMirrorTest(U"\u202E((a)) [[b]]\u202C", 0);
+
+    for (const auto &text : BidiText::generate(400, 30, 200)) {
+        bulkMirrorTest(text, SBLevelDefaultLTR);
+        bulkMirrorTest(text, 1);
+    }
+}
+
+void LineTester::testVisualRanges()
+{
+    /* Test the selections within a single run. */
+    visualRangeTest(U"abc def", 0, 0, 7, 2, 3);
+    visualRangeTest(U"אבג דהו", 1, 0, 7, 2, 3);
+
+    /* Test the selections spanning runs of different directions. */
+    visualRangeTest(U"abc אבג def", 0, 0, 11, 2, 5);
+    visualRangeTest(U"abc אבג def", 0, 0, 11, 4, 3);
+    visualRangeTest(U"abc אבג def", 1, 0, 11, 0, 11);
+    visualRangeTest(U"abc אבג 123 def", 0, 0, 15, 6, 7);
+
+    /* Test the selections partially outside the line. */
+    visualRangeTest(U"abc אבג def ghi", 0, 4, 8, 0, 6);
+    visualRangeTest(U"abc אבג def ghi", 0, 4, 8, 10, 20);
+    visualRangeTest(U"abc אבג def ghi", 0, 4, 8, 13, 2);
+
+    /* Test the selections whose limit does not fit in an integer. */
+    visualRangeTest(U"abc אבג def ghi", 0, 4, 8, 0, SBUInteger(-1));
+    visualRangeTest(U"abc אבג def ghi", 0, 4, 8, 6, SBUInteger(-1));
+    visualRangeTest(U"abc אבג def ghi", 0, 4, 8, SBUInteger(-2), SBUInteger(-1));
+
+    mt19937 generator(440);
+    for (const auto &text : BidiText::generate(440, 30, 120)) {
+        SBUInteger offset = generator() % text.length();
+        SBUInteger length = generator() % (text.length() - offset + 1);
+
+        visualRangeTest(text, SBLevelDefaultLTR, 0, text.length(), offset, length);
+        visualRangeTest(text, 1, 0, text.length(), offset, length);
+    }
+}
+
+void LineTester::testItems()
+{
+    /* Test without any attribute boundary inside the runs. */
+    itemsTest(U"abc אבג def", 0, { });
+    itemsTest(U"abc אבג def", 0, { 0, 4, 7 });
+
+    /* Test the boundaries inside the runs of both directions. */
+    itemsTest(U"abc אבג def", 0, { 0, 2, 5, 9 });
+    itemsTest(U"abc אבגדה def", 1, { 0, 5, 6, 7 });
+
+    /* Test the boundaries starting after the line and the empty attribute runs. */
+    itemsTest(U"אבג abc דהו", 1, { 2, 5, 5, 9 });
+    itemsTest(U"אבג abc דהו", 0, { 0, 11, 20 });
+
+    mt19937 generator(510);
+    for (const auto &text : BidiText::generate(510, 30, 150)) {
+        vector<SBUInteger> attributes = { 0 };
+        while (attributes.back() < text.length()) {
+            attributes.push_back(attributes.back() + 1 + generator() % 12);
+        }
+
+        itemsTest(text, SBLevelDefaultLTR, attributes);
+        itemsTest(text, 1, attributes);
+    }
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+extern "C" {
+#include <Headers/SBBase.h>
+#include <Headers/SBCodepoint.h>
+#include <Headers/SBLine.h>
+#include <Headers/SBMirrorLocator.h>
+#include <Headers/SBParagraph.h>
+#include <Headers/SBRun.h>
+}
+
+#include <cassert>
+#include <string>
+#include <vector>
+
+#include "Utilities/BidiText.h"
+#include "Utilities/Document.h"
+
+#include "MirrorLocatorTester.h"
+
+using namespace std;
+using namespace SheenBidi::Tester;
+using namespace SheenBidi::Tester::Utilities;
+
+static void skippingTest(const u32string &text, SBLevel baseLevel)
+{
+    Document document(text, baseLevel);
+    SBLineRef line = SBParagraphCreateLine(document.paragraph, 0, text.length());
+    SBUInteger runCount = SBLineGetRunCount(line);
+    const SBRun *runs = SBLineGetRunsPtr(line);
+
+    vector<pair<SBUInteger, SBCodepoint>> expected;
+    for (SBUInteger i = 0; i < runCount; i++) {
+        if (runs[i].level & 1) {
+            for (SBUInteger j = runs[i].offset; j < runs[i].offset + runs[i].length; j++) {
+                SBCodepoint mirror = SBCodepointGetMirror(text[j]);
+                if (mirror) {
+                    expected.push_back({ j, mirror });
+                }
+            }
+        }
+    }
+
+    vector<pair<SBUInteger, SBCodepoint>> located;
+    SBMirrorLocatorRef locator = SBMirrorLocatorCreate();
+    SBMirrorLocatorLoadLine(locator, line, document.sequence.stringBuffer);
+    const SBMirrorAgent *agent = SBMirrorLocatorGetAgent(locator);
+
+    while (SBMirrorLocatorMoveNext(locator)) {
+        located.push_back({ agent->index, agent->mirror });
+    }
+
+    assert(located == expected);
+
+    SBMirrorLocatorRelease(locator);
+    SBLineRelease(line);
+}
+
+MirrorLocatorTester::MirrorLocatorTester()
+{
+}
+
+void MirrorLocatorTester::test()
+{
+    /* Test the runs without any mirrorable code point. */
+    skippingTest(U"abc def", 1);
+    skippingTest(U"שלום עולם אבג", 1);
+    skippingTest(U"(abc) [def] <ghi>", 0);
+    skippingTest(U"שלום - עולם, אבג!", 1);
+
+    /* Test the mirrorable code points at the boundaries of runs and bit groups. */
+    skippingTest(U"(שלום)", 0);
+    skippingTest(U"אבגדהוז(ח)טיכלמנ<סעפצקרשת>", 1);
+    skippingTest(U"abc (אב) [def] {גד}", 0);
+
+    /* Test the long right-to-left lines with sparse brackets. */
+    u32string text(1000, U'א');
+    text[7] = U'(';
+    text[8] = U')';
+    text[500] = U'<';
+    text[999] = U'>';
+    skippingTest(text, 1);
+
+    for (const auto &random : BidiText::generate(370, 30, 200)) {
+        skippingTest(random, SBLevelDefaultLTR);
+        skippingTest(random, 1);
+    }
+}
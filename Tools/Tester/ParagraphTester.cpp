@@ -0,0 +1,339 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+extern "C" {
+#include <Headers/SBAlgorithm.h>
+#include <Headers/SBBase.h>
+#include <Headers/SBLine.h>
+#include <Headers/SBParagraph.h>
+#include <Headers/SBParagraphRuns.h>
+#include <Headers/SBRun.h>
+}
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Utilities/BidiText.h"
+#include "Utilities/Document.h"
+#include "Utilities/ThreadExecutor.h"
+
+#include "ParagraphTester.h"
+
+using namespace std;
+using namespace SheenBidi::Tester;
+using namespace SheenBidi::Tester::Utilities;
+
+static void parallelTest(const u32string &text, const vector<SBUInteger> &lengths, SBUInteger concurrency)
+{
+    Document document(text, SBLevelDefaultLTR);
+    ThreadExecutor executor(concurrency);
+    vector<SBLineRef> lines(lengths.size());
+
+    bool created = SBParagraphCreateLinesParallel(document.paragraph, 0,
+                                                  lengths.data(), lengths.size(),
+                                                  executor.executor(), lines.data());
+    assert(created);
+    assert(executor.submitCount() == (concurrency > 1 && lengths.size() > 1
+                                      ? min(concurrency, (SBUInteger)lengths.size()) : 0));
+
+    SBUInteger offset = 0;
+
+    for (size_t i = 0; i < lengths.size(); i++) {
+        SBLineRef expected = SBParagraphCreateLine(document.paragraph, offset, lengths[i]);
+        assert(BidiText::isEqual(lines[i], expected));
+
+        SBLineRelease(expected);
+        SBLineRelease(lines[i]);
+
+        offset += lengths[i];
+    }
+}
+
+static void pairTest(const u32string &text, SBUInteger offset)
+{
+    Document document(text, 0);
+    SBParagraphRef ltrParagraph;
+    SBParagraphRef rtlParagraph;
+
+    bool created = SBAlgorithmCreateParagraphPair(document.algorithm, offset, text.length() - offset,
+                                                  &ltrParagraph, &rtlParagraph);
+    assert(created);
+
+    SBParagraphRef pair[] = { ltrParagraph, rtlParagraph };
+
+    for (SBLevel level = 0; level <= 1; level++) {
+        SBParagraphRef expected = SBAlgorithmCreateParagraph(document.algorithm, offset, text.length() - offset, level);
+        SBParagraphRef paragraph = pair[level];
+        SBUInteger length = SBParagraphGetLength(expected);
+
+        assert(SBParagraphGetOffset(paragraph) == SBParagraphGetOffset(expected));
+        assert(SBParagraphGetLength(paragraph) == length);
+        assert(SBParagraphGetBaseLevel(paragraph) == level);
+        assert(memcmp(SBParagraphGetLevelsPtr(paragraph), SBParagraphGetLevelsPtr(expected),
+                      sizeof(SBLevel) * length) == 0);
+
+        /* The paragraph must be usable for creating lines as well. */
+        SBLineRef line = SBParagraphCreateLine(paragraph, offset, length);
+        SBLineRef expectedLine = SBParagraphCreateLine(expected, offset, length);
+        assert(BidiText::isEqual(line, expectedLine));
+
+        SBLineRelease(expectedLine);
+        SBLineRelease(line);
+        SBParagraphRelease(expected);
+        SBParagraphRelease(paragraph);
+    }
+}
+
+static void runsTest(const u32string &text, SBUInteger offset, SBLevel baseLevel)
+{
+    Document document(text, baseLevel);
+    SBParagraphRef paragraph = SBAlgorithmCreateParagraph(document.algorithm, offset, text.length() - offset, baseLevel);
+    SBParagraphRunsRef paragraphRuns = SBAlgorithmCreateParagraphRuns(document.algorithm, offset, text.length() - offset, baseLevel);
+    const SBLevel *levels = SBParagraphGetLevelsPtr(paragraph);
+    SBUInteger length = SBParagraphGetLength(paragraph);
+
+    assert(paragraphRuns != NULL);
+    assert(SBParagraphRunsGetOffset(paragraphRuns) == offset);
+    assert(SBParagraphRunsGetLength(paragraphRuns) == length);
+    assert(SBParagraphRunsGetBaseLevel(paragraphRuns) == SBParagraphGetBaseLevel(paragraph));
+
+    /* The runs must cover the paragraph contiguously with distinct levels of the adjacent ones. */
+    const SBRun *runs = SBParagraphRunsGetRunsPtr(paragraphRuns);
+    SBUInteger runCount = SBParagraphRunsGetRunCount(paragraphRuns);
+    SBUInteger index = offset;
+
+    for (SBUInteger i = 0; i < runCount; i++) {
+        assert(runs[i].offset == index && runs[i].length > 0);
+        assert(i == 0 || runs[i].level != runs[i - 1].level);
+
+        for (SBUInteger j = 0; j < runs[i].length; j++) {
+            assert(levels[index - offset + j] == runs[i].level);
+        }
+        index += runs[i].length;
+    }
+    assert(index == offset + length);
+
+    /* Test the point queries and the masks of a few ranges. */
+    for (index = offset; index < offset + length; index++) {
+        assert(SBParagraphRunsGetLevelAt(paragraphRuns, index) == levels[index - offset]);
+    }
+    assert(SBParagraphRunsGetLevelAt(paragraphRuns, offset + length) == SBLevelInvalid);
+    assert(offset == 0 || SBParagraphRunsGetLevelAt(paragraphRuns, offset - 1) == SBLevelInvalid);
+
+    const SBUInteger ranges[][2] = { { offset, length }, { offset + 3, 13 }, { 0, offset + length + 9 } };
+
+    for (const auto &range : ranges) {
+        vector<SBUInt8> mask((range[1] + 7) / 8, 0xFF);
+        SBParagraphRunsGetOddLevelMask(paragraphRuns, range[0], range[1], mask.data());
+
+        for (SBUInteger i = 0; i < range[1]; i++) {
+            SBUInteger stringIndex = range[0] + i;
+            bool isOdd = (stringIndex >= offset && stringIndex < offset + length
+                          && (levels[stringIndex - offset] & 1));
+            assert(((mask[i / 8] >> (i % 8)) & 1) == isOdd);
+        }
+    }
+
+    SBParagraphRunsRelease(paragraphRuns);
+    SBParagraphRelease(paragraph);
+}
+
+static SBInteger recordRun(void *object, const SBRun *run)
+{
+    auto runs = static_cast<vector<SBRun> *>(object);
+    runs->push_back(*run);
+
+    return run->length;
+}
+
+static void fittingRunsTest(const u32string &text, SBLevel baseLevel, SBUInteger lineOffset)
+{
+    Document document(text, baseLevel);
+
+    for (SBUInteger length = 1; lineOffset + length <= text.length(); length++) {
+        SBLineRef line = SBParagraphCreateLine(document.paragraph, lineOffset, length);
+        vector<SBRun> expected(SBLineGetRunsPtr(line), SBLineGetRunsPtr(line) + SBLineGetRunCount(line));
+        sort(expected.begin(), expected.end(), [](const SBRun &a, const SBRun &b) {
+            return a.offset < b.offset;
+        });
+
+        /* Test that a single candidate is measured with the runs of its actual line. */
+        vector<SBRun> measured;
+        SBLineRef fitted = SBParagraphCreateFittingLine(document.paragraph, lineOffset, &length, 1,
+                                                        0, recordRun, &measured);
+
+        assert(measured.size() == expected.size());
+        for (size_t i = 0; i < measured.size(); i++) {
+            assert(measured[i].offset == expected[i].offset);
+            assert(measured[i].length == expected[i].length);
+            assert(measured[i].level == expected[i].level);
+        }
+        assert(BidiText::isEqual(fitted, line));
+
+        SBLineRelease(fitted);
+        SBLineRelease(line);
+    }
+}
+
+ParagraphTester::ParagraphTester()
+{
+}
+
+void ParagraphTester::test()
+{
+    testParallelLines();
+    testParagraphPair();
+    testParagraphRuns();
+    testShortText();
+    testLineFitting();
+}
+
+void ParagraphTester::testParallelLines()
+{
+    const u32string text = U"Line one (اول) آخر 123 end. دوسری لائن [with مخلوط text] ۴۵۶.";
+    const vector<SBUInteger> lengths = { 5, 4, 6, 5, 8, 6, 5, 11, 7, 4 };
+
+    /* Test without an executor and with executors of varying concurrency. */
+    parallelTest(text, lengths, 0);
+    parallelTest(text, lengths, 1);
+    parallelTest(text, lengths, 2);
+    parallelTest(text, lengths, 3);
+    parallelTest(text, lengths, 16);
+    parallelTest(text, { text.length() }, 4);
+
+    /* Test with a range going past the paragraph. */
+    Document document(text, SBLevelDefaultLTR);
+    ThreadExecutor executor(4);
+    vector<SBUInteger> invalid = { 10, text.length() };
+    vector<SBLineRef> lines(invalid.size());
+
+    bool created = SBParagraphCreateLinesParallel(document.paragraph, 0,
+                                                  invalid.data(), invalid.size(),
+                                                  executor.executor(), lines.data());
+    assert(!created);
+    assert(lines[0] == NULL && lines[1] == NULL);
+
+    /* Test with an empty line. */
+    invalid = { 10, 0, 5 };
+    lines.resize(invalid.size());
+
+    created = SBParagraphCreateLinesParallel(document.paragraph, 0,
+                                             invalid.data(), invalid.size(),
+                                             executor.executor(), lines.data());
+    assert(!created);
+}
+
+void ParagraphTester::testParagraphPair()
+{
+    for (const auto &text : BidiText::generate(60, 20, 300)) {
+        pairTest(text, 0);
+    }
+
+    pairTest(U"abc\n\u05D0\u05D1 (123)", 0);
+    pairTest(U"abc\n\u05D0\u05D1 (123)", 4);
+
+    /* A paragraph that failed to be created may be retained and released like any other. */
+    assert(SBParagraphRetain(NULL) == NULL);
+    SBParagraphRelease(NULL);
+}
+
+void ParagraphTester::testParagraphRuns()
+{
+    for (const auto &text : BidiText::generate(80, 20, 250)) {
+        runsTest(text, 0, SBLevelDefaultLTR);
+        runsTest(text, 0, 1);
+    }
+
+    runsTest(U"\u202Babc\u202C \u05D0\u05D1\u05D2 123", 0, SBLevelDefaultLTR);
+    runsTest(U"xyz\n\u00AD\u202Aabc \u05D0\u05D1\u05D2 123", 4, SBLevelDefaultRTL);
+}
+
+void ParagraphTester::testShortText()
+{
+    /* Test the lengths around the capacity of the inline storage of the short paragraphs. */
+    for (SBUInteger length : { 1, 2, 32, 63, 64, 65, 66, 67, 130 }) {
+        for (const auto &text : BidiText::generate(200, 10, length)) {
+            Document document(text, SBLevelDefaultLTR);
+
+            /* The levels must not depend on the paragraph being resolved with inline storage. */
+            SBParagraphRef paragraph = SBAlgorithmCreateParagraph(document.algorithm, 0, length, SBLevelDefaultLTR);
+            SBParagraphRunsRef paragraphRuns = SBAlgorithmCreateParagraphRuns(document.algorithm, 0, length, SBLevelDefaultLTR);
+            const SBLevel *levels = SBParagraphGetLevelsPtr(paragraph);
+
+            assert(SBParagraphGetLength(paragraph) == length);
+            for (SBUInteger i = 0; i < length; i++) {
+                assert(levels[i] == SBParagraphRunsGetLevelAt(paragraphRuns, i));
+            }
+
+            /* The runs of the line must cover it completely. */
+            SBLineRef line = SBParagraphCreateLine(paragraph, 0, length);
+            SBUInteger covered = 0;
+
+            for (SBUInteger i = 0; i < SBLineGetRunCount(line); i++) {
+                covered += SBLineGetRunsPtr(line)[i].length;
+            }
+            assert(covered == length);
+
+            SBLineRelease(line);
+            SBParagraphRunsRelease(paragraphRuns);
+            SBParagraphRelease(paragraph);
+        }
+    }
+}
+
+void ParagraphTester::testLineFitting()
+{
+    /* Test the trial runs against the actual lines. */
+    fittingRunsTest(U"abc אבג def", 0, 0);
+    fittingRunsTest(U"אבג  abc  \t דהו  ", 1, 0);
+    fittingRunsTest(U"abc \u2067אבג\u2069 def \u202Bגד\u202C  ", 0, 2);
+    for (const auto &text : BidiText::generate(500, 10, 60)) {
+        fittingRunsTest(text, SBLevelDefaultLTR, 0);
+        fittingRunsTest(text, 1, 5);
+    }
+
+    /* Test the choice among several candidates. */
+    Document document(U"The quick brown fox jumps over the lazy dog", 0);
+    vector<SBUInteger> lengths = { 3, 9, 15, 19, 25, 30 };
+    vector<SBRun> measured;
+
+    SBLineRef line = SBParagraphCreateFittingLine(document.paragraph, 0, lengths.data(), lengths.size(),
+                                                  20, recordRun, &measured);
+    assert(SBLineGetLength(line) == 19);
+    SBLineRelease(line);
+
+    line = SBParagraphCreateFittingLine(document.paragraph, 4, lengths.data(), lengths.size(),
+                                        2, recordRun, &measured);
+    assert(SBLineGetLength(line) == 3);
+    SBLineRelease(line);
+
+    line = SBParagraphCreateFittingLine(document.paragraph, 0, lengths.data(), lengths.size(),
+                                        100, recordRun, &measured);
+    assert(SBLineGetLength(line) == 30);
+    SBLineRelease(line);
+
+    /* Test the invalid candidates. */
+    vector<SBUInteger> unordered = { 9, 3 };
+    assert(!SBParagraphCreateFittingLine(document.paragraph, 0, unordered.data(), unordered.size(),
+                                         20, recordRun, &measured));
+    vector<SBUInteger> overflowing = { 3, 50 };
+    assert(!SBParagraphCreateFittingLine(document.paragraph, 0, overflowing.data(), overflowing.size(),
+                                         20, recordRun, &measured));
+    assert(!SBParagraphCreateFittingLine(document.paragraph, 0, NULL, 0, 20, recordRun, &measured));
+}
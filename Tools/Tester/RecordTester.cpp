@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+extern "C" {
+#include <Headers/SBBase.h>
+#include <Headers/SBLine.h>
+#include <Headers/SBMirrorLocator.h>
+#include <Headers/SBParagraph.h>
+#include <Headers/SBRecord.h>
+#include <Headers/SBRun.h>
+}
+
+#include <cassert>
+#include <string>
+#include <vector>
+
+#include "Utilities/BidiText.h"
+#include "Utilities/Document.h"
+
+#include "RecordTester.h"
+
+using namespace std;
+using namespace SheenBidi::Tester;
+using namespace SheenBidi::Tester::Utilities;
+
+static void recordTest(const u32string &text, const vector<SBUInteger> &lengths)
+{
+    Document document(text, SBLevelDefaultLTR);
+    vector<SBLineRef> lines;
+    SBUInteger offset = 0;
+
+    for (SBUInteger length : lengths) {
+        lines.push_back(SBParagraphCreateLine(document.paragraph, offset, length));
+        offset += length;
+    }
+
+    SBUInteger size = SBRecordWrite(document.paragraph, lines.data(), lines.size(), NULL, 0);
+    assert(size > 0 && size % 4 == 0);
+
+    /* A record must be written only if the buffer is large enough. */
+    vector<SBUInt32> buffer(size / 4 + 1, 0);
+    assert(SBRecordWrite(document.paragraph, lines.data(), lines.size(), buffer.data(), size - 1) == size);
+    assert(buffer[0] == 0);
+    assert(SBRecordWrite(document.paragraph, lines.data(), lines.size(), buffer.data(), size) == size);
+
+    SBRecordView view;
+    bool initialized = SBRecordViewInitialize(&view, buffer.data(), size);
+    assert(initialized);
+    assert(SBRecordViewGetSize(&view) == size);
+    assert(SBRecordViewGetOffset(&view) == 0);
+    assert(SBRecordViewGetLength(&view) == text.length());
+    assert(SBRecordViewGetBaseLevel(&view) == SBParagraphGetBaseLevel(document.paragraph));
+
+    /* The level runs must reproduce the levels of the paragraph. */
+    const SBLevel *levels = SBParagraphGetLevelsPtr(document.paragraph);
+    SBUInteger index = 0;
+
+    for (SBUInteger i = 0; i < SBRecordViewGetLevelRunCount(&view); i++) {
+        SBRun run;
+        SBRecordViewGetLevelRun(&view, i, &run);
+        assert(run.offset == index);
+
+        for (SBUInteger j = 0; j < run.length; j++) {
+            assert(levels[index + j] == run.level);
+        }
+        index += run.length;
+    }
+    assert(index == text.length());
+
+    for (index = 0; index < text.length(); index++) {
+        assert(SBRecordViewGetLevelAt(&view, index) == levels[index]);
+    }
+    assert(SBRecordViewGetLevelAt(&view, text.length()) == SBLevelInvalid);
+
+    /* The lines must match the original ones along with their mirrors. */
+    SBMirrorLocatorRef locator = SBMirrorLocatorCreate();
+    assert(SBRecordViewGetLineCount(&view) == lines.size());
+
+    for (size_t i = 0; i < lines.size(); i++) {
+        SBLineRef line = lines[i];
+        const SBRun *runs = SBLineGetRunsPtr(line);
+
+        assert(SBRecordViewGetLineOffset(&view, i) == SBLineGetOffset(line));
+        assert(SBRecordViewGetLineLength(&view, i) == SBLineGetLength(line));
+        assert(SBRecordViewGetLineRunCount(&view, i) == SBLineGetRunCount(line));
+
+        for (SBUInteger j = 0; j < SBLineGetRunCount(line); j++) {
+            SBRun run;
+            SBRecordViewGetLineRun(&view, i, j, &run);
+            assert(run.offset == runs[j].offset && run.length == runs[j].length && run.level == runs[j].level);
+        }
+
+        SBUInteger mirrorCount = 0;
+        SBMirrorLocatorLoadLine(locator, line, (void *)document.string.data());
+
+        while (SBMirrorLocatorMoveNext(locator)) {
+            const SBMirrorAgent *expected = SBMirrorLocatorGetAgent(locator);
+            SBMirrorAgent agent;
+
+            assert(mirrorCount < SBRecordViewGetLineMirrorCount(&view, i));
+            SBRecordViewGetLineMirror(&view, i, mirrorCount, &agent);
+            assert(agent.index == expected->index);
+            assert(agent.mirror == expected->mirror);
+            assert(agent.codepoint == expected->codepoint);
+
+            mirrorCount += 1;
+        }
+        assert(mirrorCount == SBRecordViewGetLineMirrorCount(&view, i));
+    }
+
+    SBMirrorLocatorRelease(locator);
+
+    /* Truncated and corrupted records must be rejected. */
+    assert(!SBRecordViewInitialize(&view, buffer.data(), size - 4));
+    buffer[1] += 1;
+    assert(!SBRecordViewInitialize(&view, buffer.data(), size));
+    buffer[1] -= 1;
+    buffer[6] = 0x7FFFFFFF;
+    assert(!SBRecordViewInitialize(&view, buffer.data(), size));
+
+    for (SBLineRef line : lines) {
+        SBLineRelease(line);
+    }
+}
+
+RecordTester::RecordTester()
+{
+}
+
+void RecordTester::test()
+{
+    recordTest(U"abc (\u05D0\u05D1 [1]) <x> \u05D2{\u05D3}", { 7, 8, 6 });
+    recordTest(U"\u05D0", { 1 });
+    recordTest(U"xyz", { });
+
+    for (const auto &text : BidiText::generate(240, 10, 120)) {
+        recordTest(text, { 30, 30, 30, 30 });
+    }
+}
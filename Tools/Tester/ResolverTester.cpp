@@ -0,0 +1,244 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+extern "C" {
+#include <Headers/SBAlgorithm.h>
+#include <Headers/SBBase.h>
+#include <Headers/SBParagraph.h>
+#include <Headers/SBResolver.h>
+}
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Utilities/BidiText.h"
+#include "Utilities/Document.h"
+
+#include "ResolverTester.h"
+
+using namespace std;
+using namespace SheenBidi::Tester;
+using namespace SheenBidi::Tester::Utilities;
+
+static void resolverTest(const u32string &text, SBLevel baseLevel, SBUInteger budget)
+{
+    Document document(text, baseLevel);
+    SBResolverRef resolver = SBAlgorithmCreateResolver(document.algorithm, 0, text.length(), baseLevel);
+    SBUInteger stepCount = 0;
+
+    assert(resolver != NULL);
+    assert(SBResolverGetStatus(resolver) == SBResolverStatusInProgress);
+    assert(SBResolverGetParagraph(resolver) == NULL);
+
+    while (SBResolverStep(resolver, budget) == SBResolverStatusInProgress) {
+        assert(SBResolverGetParagraph(resolver) == NULL);
+        stepCount += 1;
+    }
+
+    /* A limited budget must not let the whole paragraph be resolved in a single step. */
+    assert(budget >= text.length() || stepCount > 0);
+    assert(SBResolverGetStatus(resolver) == SBResolverStatusCompleted);
+    assert(SBResolverStep(resolver, budget) == SBResolverStatusCompleted);
+
+    SBParagraphRef paragraph = SBResolverGetParagraph(resolver);
+    SBParagraphRef expected = document.paragraph;
+
+    assert(paragraph != NULL);
+    assert(SBParagraphGetOffset(paragraph) == SBParagraphGetOffset(expected));
+    assert(SBParagraphGetLength(paragraph) == SBParagraphGetLength(expected));
+    assert(SBParagraphGetBaseLevel(paragraph) == SBParagraphGetBaseLevel(expected));
+    assert(memcmp(SBParagraphGetLevelsPtr(paragraph), SBParagraphGetLevelsPtr(expected),
+                  sizeof(SBLevel) * SBParagraphGetLength(expected)) == 0);
+
+    /* The paragraph must outlive the resolver when retained. */
+    SBParagraphRetain(paragraph);
+    SBResolverRelease(resolver);
+    SBParagraphRelease(paragraph);
+}
+
+static SBResolverStatus createWithLimits(const u32string &text, const SBResourceLimits &limits)
+{
+    Document document(text, SBLevelDefaultLTR);
+    SBResolverStatus status;
+    SBParagraphRef paragraph = SBAlgorithmCreateParagraphWithLimits(document.algorithm, 0, text.length(),
+                                                                    SBLevelDefaultLTR, &limits, &status);
+    assert((paragraph != NULL) == (status == SBResolverStatusCompleted));
+
+    if (paragraph) {
+        assert(memcmp(SBParagraphGetLevelsPtr(paragraph), SBParagraphGetLevelsPtr(document.paragraph),
+                      sizeof(SBLevel) * text.length()) == 0);
+        SBParagraphRelease(paragraph);
+    }
+
+    /* The stepped resolution must hit the same limit. */
+    SBResolverRef resolver = SBAlgorithmCreateResolverWithLimits(document.algorithm, 0, text.length(),
+                                                                 SBLevelDefaultLTR, &limits);
+    while (SBResolverStep(resolver, 5) == SBResolverStatusInProgress) { }
+    assert(SBResolverGetStatus(resolver) == status);
+    assert((SBResolverGetParagraph(resolver) != NULL) == (status == SBResolverStatusCompleted));
+    SBResolverRelease(resolver);
+
+    return status;
+}
+
+static void progressiveTest(const u32string &text, const vector<SBUInteger> &requests)
+{
+    Document document(text, SBLevelDefaultRTL);
+    SBResolverRef resolver = SBAlgorithmCreateResolver(document.algorithm, 0, text.length(), SBLevelDefaultRTL);
+    const SBLevel *expected = SBParagraphGetLevelsPtr(document.paragraph);
+    SBUInteger length = SBParagraphGetLength(document.paragraph);
+    SBUInteger priorLength = 0;
+
+    for (SBUInteger request : requests) {
+        SBResolverStatus status = SBResolverAdvance(resolver, request);
+        SBUInteger resolvedLength = SBResolverGetResolvedLength(resolver);
+        const SBLevel *levels = SBResolverGetLevelsPtr(resolver);
+
+        assert(status == SBResolverStatusInProgress || status == SBResolverStatusCompleted);
+        assert(resolvedLength >= min(request, length) && resolvedLength >= priorLength);
+        assert(status != SBResolverStatusCompleted || resolvedLength == length);
+        assert(memcmp(levels, expected, sizeof(SBLevel) * resolvedLength) == 0);
+
+        priorLength = resolvedLength;
+    }
+
+    while (SBResolverStep(resolver, 1024) == SBResolverStatusInProgress) { }
+    assert(SBResolverGetStatus(resolver) == SBResolverStatusCompleted);
+    assert(memcmp(SBResolverGetLevelsPtr(resolver), expected, sizeof(SBLevel) * length) == 0);
+
+    SBResolverRelease(resolver);
+}
+
+ResolverTester::ResolverTester()
+{
+}
+
+void ResolverTester::test()
+{
+    testResolver();
+    testLimits();
+    testProgressiveResolution();
+}
+
+void ResolverTester::testResolver()
+{
+    const SBUInteger budgets[] = { 1, 7, 64 };
+
+    for (unsigned int seed = 1; seed <= 8; seed++) {
+        u32string text = BidiText::generate(seed, 200 + seed * 50);
+
+        for (SBUInteger budget : budgets) {
+            resolverTest(text, SBLevelDefaultLTR, budget);
+            resolverTest(text, 1, budget);
+        }
+    }
+
+    /* Test with a single character and with an abandoned resolver. */
+    resolverTest(U"a", SBLevelDefaultRTL, 1);
+
+    Document document(U"abc \u05D0\u05D1\u05D2", SBLevelDefaultLTR);
+    SBResolverRef resolver = SBAlgorithmCreateResolver(document.algorithm, 0, 7, SBLevelDefaultLTR);
+    assert(SBResolverStep(resolver, 1) == SBResolverStatusInProgress);
+    SBResolverRelease(resolver);
+
+    /* Test with an empty range. */
+    assert(SBAlgorithmCreateResolver(document.algorithm, 7, 1, SBLevelDefaultLTR) == NULL);
+}
+
+void ResolverTester::testLimits()
+{
+    const u32string text = BidiText::generate(9, 400);
+    SBResourceLimits limits = { 0, 0, 0 };
+
+    /* Test without any limit. */
+    assert(createWithLimits(text, limits) == SBResolverStatusCompleted);
+
+    /* Test the paragraph length limit. */
+    limits.maxParagraphLength = text.length();
+    assert(createWithLimits(text, limits) == SBResolverStatusCompleted);
+    limits.maxParagraphLength = text.length() - 1;
+    assert(createWithLimits(text, limits) == SBResolverStatusLimitExceeded);
+
+    /* Test the operation limit. */
+    limits = { 0, 0, 1 };
+    assert(createWithLimits(text, limits) == SBResolverStatusLimitExceeded);
+    limits.maxOperations = text.length() * 8;
+    assert(createWithLimits(text, limits) == SBResolverStatusCompleted);
+
+    /*
+     * Find the memory needed by a plain paragraph, and make sure that a paragraph of the same length
+     * queuing many level runs behind an unterminated isolate is refused with the same limit.
+     */
+    const size_t length = 4000;
+    const u32string plain(length, U'a');
+    u32string nested = U"\u2067";
+
+    while (nested.length() < length) {
+        nested += U"\u202Aa\u202C\u05D0";
+    }
+    nested.resize(length);
+
+    SBUInteger lower = 1;
+    SBUInteger upper = 1 << 24;
+
+    while (lower < upper) {
+        SBUInteger middle = lower + (upper - lower) / 2;
+
+        limits = { 0, middle, 0 };
+        if (createWithLimits(plain, limits) == SBResolverStatusCompleted) {
+            upper = middle;
+        } else {
+            lower = middle + 1;
+        }
+    }
+
+    limits = { 0, lower, 0 };
+    assert(createWithLimits(nested, limits) == SBResolverStatusLimitExceeded);
+    limits.maxAllocatedBytes = 0;
+    assert(createWithLimits(nested, limits) == SBResolverStatusCompleted);
+}
+
+void ResolverTester::testProgressiveResolution()
+{
+    /*
+     * Test that the first screen of a long paragraph is resolved without the rest of it. The
+     * embeddings split the paragraph into many isolating runs.
+     */
+    u32string text;
+    while (text.length() < 8000) {
+        text += U"abc \u202B(\u05D0\u05D1\u05D2) 123\u202C, ";
+    }
+
+    Document document(text, SBLevelDefaultLTR);
+    SBResolverRef resolver = SBAlgorithmCreateResolver(document.algorithm, 0, text.length(), SBLevelDefaultLTR);
+
+    assert(SBResolverGetResolvedLength(resolver) == 0);
+    assert(SBResolverAdvance(resolver, 80) == SBResolverStatusInProgress);
+    assert(SBResolverGetResolvedLength(resolver) >= 80);
+    assert(SBResolverGetResolvedLength(resolver) < 200);
+    assert(SBResolverGetParagraph(resolver) == NULL);
+    SBResolverRelease(resolver);
+
+    progressiveTest(text, { 1, 80, 81, 4000, 7999, 8000, 8100 });
+
+    /* Test with random texts containing isolates and embeddings. */
+    for (const auto &random : BidiText::generate(10, 10, 500)) {
+        progressiveTest(random, { 0, 1, 2, 10, 50, 51, 200, 499, 500 });
+    }
+}
@@ -17,18 +17,24 @@
 extern "C" {
 #include <Headers/SBBase.h>
 #include <Headers/SBCodepointSequence.h>
+#include <Headers/SBExecutor.h>
 #include <Headers/SBScript.h>
 #include <Headers/SBScriptLocator.h>
 }
 
 #include <cassert>
+#include <cstdint>
+#include <random>
 #include <string>
 #include <vector>
 
+#include "Utilities/ThreadExecutor.h"
+
 #include "ScriptLocatorTester.h"
 
 using namespace std;
 using namespace SheenBidi::Tester;
+using namespace SheenBidi::Tester::Utilities;
 
 struct run {
     SBUInteger offset;
@@ -64,6 +70,178 @@ static void u32Test(const u32string string, const vector<run> runs)
     assert(runs == output);
 }
 
+static vector<run> locateRuns(const SBCodepointSequence &sequence, const SBExecutor *executor)
+{
+    SBScriptLocatorRef locator = SBScriptLocatorCreate();
+    const SBScriptAgent *agent = SBScriptLocatorGetAgent(locator);
+
+    if (executor) {
+        SBScriptLocatorLoadCodepointsParallel(locator, &sequence, executor);
+    } else {
+        SBScriptLocatorLoadCodepoints(locator, &sequence);
+    }
+
+    vector<run> output;
+    while (SBScriptLocatorMoveNext(locator)) {
+        output.push_back({agent->offset, agent->length, agent->script});
+    }
+
+    /* Make sure that the runs can be located again after a reset. */
+    vector<run> repeated;
+    while (SBScriptLocatorMoveNext(locator)) {
+        repeated.push_back({agent->offset, agent->length, agent->script});
+    }
+    assert(output == repeated);
+
+    SBScriptLocatorRelease(locator);
+
+    return output;
+}
+
+template<class CodeUnit>
+static void parallelTest(SBStringEncoding encoding, const basic_string<CodeUnit> &string)
+{
+    SBCodepointSequence sequence;
+    sequence.stringEncoding = encoding;
+    sequence.stringBuffer = (void *)string.data();
+    sequence.stringLength = string.length();
+
+    vector<run> expected = locateRuns(sequence, nullptr);
+
+    for (SBUInteger concurrency : { 1, 2, 3, 4, 7, 16 }) {
+        ThreadExecutor executor(concurrency);
+        assert(locateRuns(sequence, executor.executor()) == expected);
+    }
+}
+
+static string toUTF8(const u32string &string)
+{
+    std::string output;
+
+    for (char32_t codepoint : string) {
+        if (codepoint < 0x80) {
+            output.push_back((char)codepoint);
+        } else if (codepoint < 0x800) {
+            output.push_back((char)(0xC0 | (codepoint >> 6)));
+            output.push_back((char)(0x80 | (codepoint & 0x3F)));
+        } else if (codepoint < 0x10000) {
+            output.push_back((char)(0xE0 | (codepoint >> 12)));
+            output.push_back((char)(0x80 | ((codepoint >> 6) & 0x3F)));
+            output.push_back((char)(0x80 | (codepoint & 0x3F)));
+        } else {
+            output.push_back((char)(0xF0 | (codepoint >> 18)));
+            output.push_back((char)(0x80 | ((codepoint >> 12) & 0x3F)));
+            output.push_back((char)(0x80 | ((codepoint >> 6) & 0x3F)));
+            output.push_back((char)(0x80 | (codepoint & 0x3F)));
+        }
+    }
+
+    return output;
+}
+
+static u16string toUTF16(const u32string &string)
+{
+    u16string output;
+
+    for (char32_t codepoint : string) {
+        if (codepoint < 0x10000) {
+            output.push_back((char16_t)codepoint);
+        } else {
+            codepoint -= 0x10000;
+            output.push_back((char16_t)(0xD800 | (codepoint >> 10)));
+            output.push_back((char16_t)(0xDC00 | (codepoint & 0x3FF)));
+        }
+    }
+
+    return output;
+}
+
+static u32string generateText(uint32_t seed, size_t length, const u32string &punctuations)
+{
+    const vector<u32string> words = {
+        U"Script", U"line", U"تحریر", U"لائن", U"γράμμα", U"кириллица", U"漢字仮名交じり文",
+        U"\U0001D84C\U0001D84D", U"123", U"e\u0301", U"..."
+    };
+    mt19937 generator(seed);
+    u32string text;
+
+    while (text.length() < length) {
+        uint32_t choice = generator() % 16;
+
+        if (choice < 9) {
+            text += words[generator() % words.size()];
+        } else if (choice < 14) {
+            text += punctuations[generator() % punctuations.length()];
+        } else if (choice < 15) {
+            /* Nest the brackets deeper than the capacity of the stack. */
+            text += u32string(70, U'(');
+        } else {
+            text += U'\n';
+        }
+
+        text += U' ';
+    }
+
+    return text;
+}
+
+template<class CodeUnit>
+static void seekTest(SBStringEncoding encoding, const basic_string<CodeUnit> &string, SBUInteger interval)
+{
+    SBCodepointSequence sequence;
+    sequence.stringEncoding = encoding;
+    sequence.stringBuffer = (void *)string.data();
+    sequence.stringLength = string.length();
+
+    vector<run> expected = locateRuns(sequence, nullptr);
+    ThreadExecutor executor(4);
+    mt19937 generator(interval);
+
+    for (const SBExecutor *source : { (const SBExecutor *)nullptr, executor.executor() }) {
+        SBScriptLocatorRef locator = SBScriptLocatorCreate();
+        const SBScriptAgent *agent = SBScriptLocatorGetAgent(locator);
+
+        SBScriptLocatorSetCheckpointInterval(locator, interval);
+        if (source) {
+            SBScriptLocatorLoadCodepointsParallel(locator, &sequence, source);
+        } else {
+            SBScriptLocatorLoadCodepoints(locator, &sequence);
+        }
+
+        /* Seek both forward and backward, reading a few runs each time. */
+        for (size_t i = 0; i < 100; i++) {
+            SBUInteger offset = generator() % (string.length() + 10);
+            auto match = expected.begin();
+            while (match != expected.end() && match->offset + match->length <= offset) {
+                match++;
+            }
+
+            SBScriptLocatorSeek(locator, offset);
+
+            for (size_t j = 0; j < 5; j++, match++) {
+                if (match == expected.end()) {
+                    assert(!SBScriptLocatorMoveNext(locator));
+                    break;
+                }
+
+                assert(SBScriptLocatorMoveNext(locator));
+                assert((run { agent->offset, agent->length, agent->script }) == *match);
+            }
+        }
+
+        /* Make sure that the runs can be located from the beginning after seeking. */
+        SBScriptLocatorSeek(locator, 0);
+
+        vector<run> output;
+        while (SBScriptLocatorMoveNext(locator)) {
+            output.push_back({agent->offset, agent->length, agent->script});
+        }
+        assert(output == expected);
+
+        SBScriptLocatorRelease(locator);
+    }
+}
+
 ScriptLocatorTester::ScriptLocatorTester()
 {
 }
@@ -95,4 +273,42 @@ void ScriptLocatorTester::test()
               {39, 1, SBScriptLATN}, {40, 2, SBScriptARAB} });
     /* Test with a starting bracket pair. */
     u32Test(U"[All is well]", { {0, 13, SBScriptLATN} });
+
+    /* Test with the ascii code points around other scripts. */
+    u32Test(U"123 abc, def!", { {0, 13, SBScriptLATN} });
+    u32Test(U"Привет 123 <b>", { {0, 12, SBScriptCYRL}, {12, 2, SBScriptLATN} });
+    u32Test(U"abc Привет", { {0, 4, SBScriptLATN}, {4, 6, SBScriptCYRL} });
+    u32Test(U"Привет (abc) def", { {0, 8, SBScriptCYRL}, {8, 3, SBScriptLATN},
+                                    {11, 2, SBScriptCYRL}, {13, 3, SBScriptLATN} });
+    u32Test(U"x(y[z]{w})", { {0, 10, SBScriptLATN} });
+    u32Test(U"(1) [2] {3} Привет", { {0, 18, SBScriptCYRL} });
+
+    /* Test the parallel resolution against the sequential one. */
+    for (uint32_t seed = 1; seed <= 4; seed++) {
+        u32string text = generateText(seed, 40000, U"()[]{}«»「」");
+
+        parallelTest(SBStringEncodingUTF8, toUTF8(text));
+        parallelTest(SBStringEncodingUTF16, toUTF16(text));
+        parallelTest(SBStringEncodingUTF32, text);
+    }
+    /* Test with the pairs opened in a chunk and closed in the last one. */
+    for (uint32_t seed = 5; seed <= 6; seed++) {
+        u32string text = generateText(seed, 30000, U"([{«「") + generateText(seed, 5000, U")]}»」");
+
+        parallelTest(SBStringEncodingUTF8, toUTF8(text));
+        parallelTest(SBStringEncodingUTF32, text);
+    }
+    /* Test with a text having no concrete script to split at. */
+    parallelTest(SBStringEncodingUTF32, u32string(20000, U'('));
+
+    /* Test seeking with and without the checkpoints. */
+    for (uint32_t seed = 7; seed <= 8; seed++) {
+        u32string text = generateText(seed, 12000, U"()[]{}«»「」");
+
+        seekTest(SBStringEncodingUTF8, toUTF8(text), 256);
+        seekTest(SBStringEncodingUTF16, toUTF16(text), 1000);
+        seekTest(SBStringEncodingUTF32, text, 1);
+        seekTest(SBStringEncodingUTF32, text, 0);
+    }
+    seekTest(SBStringEncodingUTF32, u32string(U"A (simple) line."), 4);
 }
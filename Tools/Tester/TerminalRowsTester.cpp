@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+extern "C" {
+#include <Headers/SBAlgorithm.h>
+#include <Headers/SBBase.h>
+#include <Headers/SBCodepoint.h>
+#include <Headers/SBCodepointSequence.h>
+#include <Headers/SBLine.h>
+#include <Headers/SBParagraph.h>
+#include <Headers/SBRun.h>
+#include <Headers/SBTerminalRows.h>
+}
+
+#include <cassert>
+#include <string>
+#include <vector>
+
+#include "Utilities/BidiText.h"
+
+#include "TerminalRowsTester.h"
+
+using namespace std;
+using namespace SheenBidi::Tester;
+using namespace SheenBidi::Tester::Utilities;
+
+static void checkRowLayout(const u32string &text, SBLevel baseLevel, const SBTerminalRowLayout &layout)
+{
+    assert(layout.cellCount == text.length());
+
+    if (text.empty()) {
+        return;
+    }
+
+    SBCodepointSequence sequence = BidiText::makeSequence(text);
+    SBAlgorithmRef algorithm = SBAlgorithmCreate(&sequence);
+    SBUInteger visualIndex = 0;
+    SBUInteger offset = 0;
+
+    while (offset < text.length()) {
+        SBParagraphRef paragraph = SBAlgorithmCreateParagraph(algorithm, offset, text.length() - offset, baseLevel);
+        SBUInteger length = SBParagraphGetLength(paragraph);
+        SBLineRef line = SBParagraphCreateLine(paragraph, offset, length);
+        const SBRun *runs = SBLineGetRunsPtr(line);
+
+        if (offset == 0) {
+            assert(layout.baseLevel == SBParagraphGetBaseLevel(paragraph));
+        }
+
+        for (SBUInteger i = 0; i < SBLineGetRunCount(line); i++) {
+            bool isRTL = runs[i].level & 1;
+
+            for (SBUInteger j = 0; j < runs[i].length; j++) {
+                SBUInteger cell = (isRTL ? runs[i].offset + runs[i].length - j - 1 : runs[i].offset + j);
+                bool isMirrored = isRTL && SBCodepointGetMirror(text[cell]) != 0;
+
+                assert(layout.visualMap[visualIndex] == cell);
+                assert(layout.mirrorFlags[visualIndex] == isMirrored);
+                visualIndex += 1;
+            }
+        }
+
+        SBLineRelease(line);
+        SBParagraphRelease(paragraph);
+        offset += length;
+    }
+
+    SBAlgorithmRelease(algorithm);
+}
+
+static bool resolveRows(SBTerminalRowsRef terminalRows, const vector<u32string> &texts,
+                        const vector<SBUInteger> &generations, SBLevel baseLevel)
+{
+    vector<SBTerminalRow> rows(texts.size());
+    vector<SBTerminalRowLayout> layouts(texts.size());
+
+    for (size_t i = 0; i < texts.size(); i++) {
+        rows[i].cells = (const SBCodepoint *)texts[i].data();
+        rows[i].cellCount = texts[i].length();
+        rows[i].generation = (generations.empty() ? 0 : generations[i]);
+    }
+
+    if (!SBTerminalRowsResolve(terminalRows, rows.data(), rows.size(), layouts.data())) {
+        return false;
+    }
+
+    for (size_t i = 0; i < texts.size(); i++) {
+        checkRowLayout(texts[i], baseLevel, layouts[i]);
+    }
+
+    return true;
+}
+
+TerminalRowsTester::TerminalRowsTester()
+{
+}
+
+void TerminalRowsTester::test()
+{
+    vector<u32string> screen = {
+        U"$ echo 'שלום (עולם)'", U"שלום (עולם)", U"", U"abc [אב] <c>", U"א\n(x)",
+        U"\u202Eright-to-left\u202C", U"שלום (עולם)", U"123 ١٢٣ {٤}"
+    };
+
+    /* Test that unchanged and duplicate rows are not resolved again. */
+    SBTerminalRowsRef terminalRows = SBTerminalRowsCreate(10, SBLevelDefaultLTR);
+    assert(resolveRows(terminalRows, screen, {}, SBLevelDefaultLTR));
+    assert(SBTerminalRowsGetMissCount(terminalRows) == 7);
+    assert(SBTerminalRowsGetHitCount(terminalRows) == 1);
+
+    assert(resolveRows(terminalRows, screen, {}, SBLevelDefaultLTR));
+    assert(SBTerminalRowsGetMissCount(terminalRows) == 7);
+
+    /* Test that scrolling resolves only the new row. */
+    screen.erase(screen.begin());
+    screen.push_back(U"new בג row");
+    assert(resolveRows(terminalRows, screen, {}, SBLevelDefaultLTR));
+    assert(SBTerminalRowsGetMissCount(terminalRows) == 8);
+
+    /* Test that least recently used rows are evicted beyond the capacity. */
+    vector<u32string> others = BidiText::generate(330, 10, 40);
+    assert(resolveRows(terminalRows, others, {}, SBLevelDefaultLTR));
+    assert(SBTerminalRowsGetMissCount(terminalRows) == 18);
+    assert(resolveRows(terminalRows, screen, {}, SBLevelDefaultLTR));
+    assert(SBTerminalRowsGetMissCount(terminalRows) == 25);
+
+    others.push_back(U"one too many");
+    assert(!SBTerminalRowsResolve(terminalRows, NULL, others.size(), NULL));
+
+    SBTerminalRowsClear(terminalRows);
+    assert(resolveRows(terminalRows, screen, {}, SBLevelDefaultLTR));
+    assert(SBTerminalRowsGetMissCount(terminalRows) == 32);
+    SBTerminalRowsRelease(terminalRows);
+
+    /* Test rows identified by their generations. */
+    terminalRows = SBTerminalRowsCreate(4, SBLevelDefaultRTL);
+    assert(resolveRows(terminalRows, { U"abc", U"א (b)" }, { 1, 2 }, SBLevelDefaultRTL));
+    assert(resolveRows(terminalRows, { U"א (b)", U"abc" }, { 2, 1 }, SBLevelDefaultRTL));
+    assert(SBTerminalRowsGetMissCount(terminalRows) == 2);
+    assert(resolveRows(terminalRows, { U"abc (ב)", U"" }, { 3, 4 }, SBLevelDefaultRTL));
+    assert(SBTerminalRowsGetMissCount(terminalRows) == 4);
+
+    /* Test that rows sharing a generation are told apart by their contents. */
+    assert(resolveRows(terminalRows, { U"xyz", U"אבג" }, { 1, 1 }, SBLevelDefaultRTL));
+    assert(SBTerminalRowsGetMissCount(terminalRows) == 6);
+    assert(resolveRows(terminalRows, { U"אבג", U"abc" }, { 1, 1 }, SBLevelDefaultRTL));
+    assert(SBTerminalRowsGetMissCount(terminalRows) == 7);
+    SBTerminalRowsRelease(terminalRows);
+
+    assert(SBTerminalRowsCreate(0, SBLevelDefaultLTR) == NULL);
+}
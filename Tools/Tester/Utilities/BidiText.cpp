@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+extern "C" {
+#include <Headers/SBBase.h>
+#include <Headers/SBCodepointSequence.h>
+#include <Headers/SBLine.h>
+#include <Headers/SBRun.h>
+}
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BidiText.h"
+
+using namespace std;
+using namespace SheenBidi::Tester::Utilities;
+
+u32string BidiText::generate(unsigned int seed, size_t length)
+{
+    /* Representatives of all bidi types, including brackets and explicit formatting characters. */
+    const char32_t samples[] = {
+        U'a', U'\u05D0', U'\u0628', U'1', U'\u0661', U'+', U'$', U',', U'\u0300', U'\u00AD',
+        U'\t', U' ', U'!', U'(', U')', U'[', U']', U'\u202A', U'\u202B', U'\u202C', U'\u202D',
+        U'\u202E', U'\u2066', U'\u2067', U'\u2068', U'\u2069'
+    };
+    const size_t sampleCount = sizeof(samples) / sizeof(samples[0]);
+
+    mt19937 generator(seed);
+    uniform_int_distribution<size_t> distribution(0, sampleCount - 1);
+    u32string text;
+
+    for (size_t i = 0; i < length; i++) {
+        text.push_back(samples[distribution(generator)]);
+    }
+
+    return text;
+}
+
+vector<u32string> BidiText::generate(unsigned int firstSeed, unsigned int count, size_t length)
+{
+    vector<u32string> texts;
+
+    for (unsigned int seed = firstSeed; seed < firstSeed + count; seed++) {
+        texts.push_back(generate(seed, length));
+    }
+
+    return texts;
+}
+
+SBCodepointSequence BidiText::makeSequence(const u32string &text)
+{
+    SBCodepointSequence sequence;
+    sequence.stringEncoding = SBStringEncodingUTF32;
+    sequence.stringBuffer = (void *)text.data();
+    sequence.stringLength = text.length();
+
+    return sequence;
+}
+
+bool BidiText::isEqual(SBLineRef first, SBLineRef second)
+{
+    if (SBLineGetOffset(first) != SBLineGetOffset(second)
+        || SBLineGetLength(first) != SBLineGetLength(second)
+        || SBLineGetRunCount(first) != SBLineGetRunCount(second)) {
+        return false;
+    }
+
+    const SBRun *firstRuns = SBLineGetRunsPtr(first);
+    const SBRun *secondRuns = SBLineGetRunsPtr(second);
+
+    for (SBUInteger i = 0; i < SBLineGetRunCount(first); i++) {
+        if (firstRuns[i].offset != secondRuns[i].offset
+            || firstRuns[i].length != secondRuns[i].length
+            || firstRuns[i].level != secondRuns[i].level) {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SHEENBIDI_TESTER_UTILITIES_BIDI_TEXT_H
+#define SHEENBIDI_TESTER_UTILITIES_BIDI_TEXT_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <Headers/SBCodepointSequence.h>
+#include <Headers/SBLine.h>
+}
+
+namespace SheenBidi {
+namespace Tester {
+namespace Utilities {
+
+class BidiText {
+public:
+    static std::u32string generate(unsigned int seed, size_t length);
+    static std::vector<std::u32string> generate(unsigned int firstSeed, unsigned int count, size_t length);
+    static SBCodepointSequence makeSequence(const std::u32string &text);
+    static bool isEqual(SBLineRef first, SBLineRef second);
+};
+
+}
+}
+}
+
+#endif
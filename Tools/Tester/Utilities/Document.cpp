@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+extern "C" {
+#include <Headers/SBAlgorithm.h>
+#include <Headers/SBBase.h>
+#include <Headers/SBCodepointSequence.h>
+#include <Headers/SBParagraph.h>
+}
+
+#include <string>
+
+#include "Document.h"
+
+using namespace std;
+using namespace SheenBidi::Tester::Utilities;
+
+Document::Document(const u32string &text, SBLevel baseLevel) :
+    string(text)
+{
+    sequence.stringEncoding = SBStringEncodingUTF32;
+    sequence.stringBuffer = (void *)string.data();
+    sequence.stringLength = string.length();
+
+    algorithm = SBAlgorithmCreate(&sequence);
+    paragraph = SBAlgorithmCreateParagraph(algorithm, 0, string.length(), baseLevel);
+}
+
+Document::~Document()
+{
+    SBParagraphRelease(paragraph);
+    SBAlgorithmRelease(algorithm);
+}
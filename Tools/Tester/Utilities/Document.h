@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SHEENBIDI_TESTER_UTILITIES_DOCUMENT_H
+#define SHEENBIDI_TESTER_UTILITIES_DOCUMENT_H
+
+#include <string>
+
+extern "C" {
+#include <Headers/SBAlgorithm.h>
+#include <Headers/SBBase.h>
+#include <Headers/SBCodepointSequence.h>
+#include <Headers/SBParagraph.h>
+}
+
+namespace SheenBidi {
+namespace Tester {
+namespace Utilities {
+
+struct Document {
+    std::u32string string;
+    SBCodepointSequence sequence;
+    SBAlgorithmRef algorithm;
+    SBParagraphRef paragraph;
+
+    Document(const std::u32string &text, SBLevel baseLevel);
+    ~Document();
+
+    Document(const Document &) = delete;
+    Document &operator=(const Document &) = delete;
+};
+
+}
+}
+}
+
+#endif
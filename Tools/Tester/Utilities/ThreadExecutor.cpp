@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+extern "C" {
+#include <Headers/SBBase.h>
+#include <Headers/SBExecutor.h>
+}
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "ThreadExecutor.h"
+
+using namespace std;
+using namespace SheenBidi::Tester::Utilities;
+
+ThreadExecutor::ThreadExecutor(SBUInteger concurrency)
+    : m_submitCount(0)
+{
+    m_executor.object = this;
+    m_executor.concurrency = concurrency;
+    m_executor.submit = submit;
+    m_executor.wait = wait;
+}
+
+ThreadExecutor::~ThreadExecutor()
+{
+    wait(this);
+}
+
+const SBExecutor *ThreadExecutor::executor() const
+{
+    return &m_executor;
+}
+
+size_t ThreadExecutor::submitCount() const
+{
+    return m_submitCount;
+}
+
+void ThreadExecutor::submit(void *object, SBExecutorTaskFunc task, void *data)
+{
+    auto self = static_cast<ThreadExecutor *>(object);
+    self->m_threads.emplace_back(task, data);
+    self->m_submitCount += 1;
+}
+
+void ThreadExecutor::wait(void *object)
+{
+    auto self = static_cast<ThreadExecutor *>(object);
+    for (auto &worker : self->m_threads) {
+        worker.join();
+    }
+    self->m_threads.clear();
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2025 Muhammad Tayyab Akram
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SHEENBIDI_TESTER_UTILITIES_THREAD_EXECUTOR_H
+#define SHEENBIDI_TESTER_UTILITIES_THREAD_EXECUTOR_H
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include <Headers/SBBase.h>
+#include <Headers/SBExecutor.h>
+}
+
+namespace SheenBidi {
+namespace Tester {
+namespace Utilities {
+
+class ThreadExecutor {
+public:
+    ThreadExecutor(SBUInteger concurrency);
+    ~ThreadExecutor();
+
+    const SBExecutor *executor() const;
+    size_t submitCount() const;
+
+private:
+    SBExecutor m_executor;
+    std::vector<std::thread> m_threads;
+    size_t m_submitCount;
+
+    static void submit(void *object, SBExecutorTaskFunc task, void *data);
+    static void wait(void *object);
+};
+
+}
+}
+}
+
+#endif
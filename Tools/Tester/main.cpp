@@ -30,13 +30,24 @@ extern "C" {
 #include <Parser/UnicodeData.h>
 
 #include "AlgorithmTester.h"
+#include "ArenaTester.h"
+#include "BatchTester.h"
 #include "BidiTypeLookupTester.h"
 #include "BracketLookupTester.h"
+#include "CacheTester.h"
 #include "CodepointSequenceTester.h"
+#include "DocumentTester.h"
 #include "GeneralCategoryLookupTester.h"
+#include "HitIndexTester.h"
+#include "LineTester.h"
+#include "MirrorLocatorTester.h"
 #include "MirrorLookupTester.h"
+#include "ParagraphTester.h"
+#include "RecordTester.h"
+#include "ResolverTester.h"
 #include "ScriptLocatorTester.h"
 #include "ScriptLookupTester.h"
+#include "TerminalRowsTester.h"
 
 using namespace std;
 using namespace SheenBidi::Parser;
@@ -61,6 +72,17 @@ int main(int argc, const char *argv[]) {
     GeneralCategoryLookupTester generalCategoryLookupTester(unicodeData);
     ScriptLookupTester scriptLookupTester(scripts, propertyValueAliases);
     AlgorithmTester algorithmTester(&bidiTest, &bidiCharacterTest, &bidiMirroring);
+    ParagraphTester paragraphTester;
+    ResolverTester resolverTester;
+    DocumentTester documentTester;
+    BatchTester batchTester;
+    ArenaTester arenaTester;
+    CacheTester cacheTester;
+    RecordTester recordTester;
+    LineTester lineTester;
+    MirrorLocatorTester mirrorLocatorTester;
+    TerminalRowsTester terminalRowsTester;
+    HitIndexTester hitIndexTester;
     ScriptLocatorTester scriptLocatorTester;
 
     bidiTypeLookupTester.test();
@@ -70,6 +92,17 @@ int main(int argc, const char *argv[]) {
     generalCategoryLookupTester.test();
     scriptLookupTester.test();
     algorithmTester.test();
+    paragraphTester.test();
+    resolverTester.test();
+    documentTester.test();
+    batchTester.test();
+    arenaTester.test();
+    cacheTester.test();
+    recordTester.test();
+    lineTester.test();
+    mirrorLocatorTester.test();
+    terminalRowsTester.test();
+    hitIndexTester.test();
     scriptLocatorTester.test();
 
     return 0;